@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    AnalyserFifo.cpp
+    Created: 18 Oct 2026 5:12:09am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "AnalyserFifo.h"
+
+AnalyserFifo::AnalyserFifo (int capacity)
+    : fifo (juce::jmax (2, capacity)),
+      samples ((size_t) juce::jmax (2, capacity))
+{
+}
+
+void AnalyserFifo::prepare (double newSampleRate) noexcept
+{
+    sampleRate.store (newSampleRate, std::memory_order_relaxed);
+}
+
+void AnalyserFifo::push (const juce::AudioBuffer<float>& buffer, int numSamples) noexcept
+{
+    const auto numChannels = buffer.getNumChannels();
+
+    if (! isReaderAttached.load (std::memory_order_relaxed) || numSamples <= 0 || numChannels == 0)
+        return;
+
+    const auto scope = fifo.write (numSamples);
+    const auto numWritten = scope.blockSize1 + scope.blockSize2;
+
+    if (numWritten < numSamples)
+        numDropped.fetch_add ((juce::uint64) (numSamples - numWritten), std::memory_order_relaxed);
+
+    // The channels are averaged rather than summed, so a centred voice reads the same in mono and stereo
+    const auto channelGain = 1.0f / (float) numChannels;
+
+    auto mixDown = [&] (int start, int size, int sourceStart)
+    {
+        if (size <= 0)
+            return;
+
+        auto* destination = samples.data() + start;
+        juce::FloatVectorOperations::copyWithMultiply (destination, buffer.getReadPointer (0, sourceStart), channelGain, size);
+
+        for (int channel = 1; channel < numChannels; ++channel)
+            juce::FloatVectorOperations::addWithMultiply (destination, buffer.getReadPointer (channel, sourceStart), channelGain, size);
+    };
+
+    mixDown (scope.startIndex1, scope.blockSize1, 0);
+    mixDown (scope.startIndex2, scope.blockSize2, scope.blockSize1);
+}
+
+void AnalyserFifo::setReaderAttached (bool isAttached) noexcept
+{
+    // Only the reader moves the read position, so it can skip what's left without the writer noticing
+    if (isAttached)
+        fifo.finishedRead (fifo.getNumReady());
+
+    isReaderAttached.store (isAttached, std::memory_order_relaxed);
+}
+
+int AnalyserFifo::pop (float* destination, int maxSamples) noexcept
+{
+    const auto scope = fifo.read (juce::jmin (maxSamples, fifo.getNumReady()));
+
+    if (scope.blockSize1 > 0)
+        std::copy_n (samples.data() + scope.startIndex1, scope.blockSize1, destination);
+
+    if (scope.blockSize2 > 0)
+        std::copy_n (samples.data() + scope.startIndex2, scope.blockSize2, destination + scope.blockSize1);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
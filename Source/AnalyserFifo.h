@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    AnalyserFifo.h
+    Created: 18 Oct 2026 5:12:09am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Carries the processor's output, mixed down to mono, from the audio thread to the editor's scope and spectrum.
+// There's a single writer (processBlock) and a single reader (the editor's timer), and neither ever waits for the other:
+// samples that don't fit are dropped and counted. While no reader is attached the writer doesn't copy anything,
+// so a plugin with its editor closed pays a single atomic load per block for it
+class AnalyserFifo
+{
+public:
+    explicit AnalyserFifo (int capacity = 16384);
+
+    // Call it while no blocks are being pushed, e.g. from prepareToPlay
+    void prepare (double newSampleRate) noexcept;
+
+    // Audio thread only. Never allocates or blocks
+    void push (const juce::AudioBuffer<float>& buffer, int numSamples) noexcept;
+
+    // The reader's side. Attaching throws away whatever was left over from the last reader
+    void setReaderAttached (bool isAttached) noexcept;
+    int pop (float* destination, int maxSamples) noexcept;
+
+    double getSampleRate() const noexcept               { return sampleRate.load (std::memory_order_relaxed); }
+    juce::uint64 getNumDropped() const noexcept         { return numDropped.load (std::memory_order_relaxed); }
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<float> samples;
+
+    std::atomic<bool> isReaderAttached { false };
+    std::atomic<double> sampleRate { 44100.0 };
+    std::atomic<juce::uint64> numDropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (AnalyserFifo)
+};
@@ -0,0 +1,44 @@
+/*
+  ==============================================================================
+
+    CpuLoadMeter.cpp
+    Created: 18 Oct 2026 4:36:27am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "CpuLoadMeter.h"
+
+void CpuLoadMeter::prepare (double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+    smoothedLoad = 0.0;
+    heldPeak = 0.0;
+
+    load.store (0.0f);
+    peakLoad.store (0.0f);
+    numNearMisses.store (0);
+    numMisses.store (0);
+}
+
+void CpuLoadMeter::addBlock (int numSamples, double elapsedSeconds) noexcept
+{
+    if (sampleRate <= 0.0 || numSamples <= 0)
+        return;
+
+    const auto deadlineSeconds = numSamples / sampleRate;
+    const auto blockLoad = elapsedSeconds / deadlineSeconds;
+
+    // The smoothing and the decay depend on how long the block lasts, so they behave the same at any block size
+    smoothedLoad += (blockLoad - smoothedLoad) * (1.0 - std::exp (-deadlineSeconds / loadSmoothingSeconds));
+    heldPeak = juce::jmax (blockLoad, heldPeak * std::pow (0.1, deadlineSeconds / peakDecaySeconds));
+
+    load.store ((float) smoothedLoad, std::memory_order_relaxed);
+    peakLoad.store ((float) heldPeak, std::memory_order_relaxed);
+
+    if (blockLoad > 1.0)
+        numMisses.fetch_add (1, std::memory_order_relaxed);
+    else if (blockLoad > nearMissThreshold)
+        numNearMisses.fetch_add (1, std::memory_order_relaxed);
+}
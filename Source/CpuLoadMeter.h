@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    CpuLoadMeter.h
+    Created: 18 Oct 2026 4:36:27am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// How much of its real-time deadline each processBlock call takes, where the deadline is the time the block lasts
+// (its length over the sample rate). The audio thread measures every block and publishes the results through atomics,
+// so any other thread can read them at whatever rate it likes without ever holding the audio thread up.
+// The whole callback is shared with the host and every other plugin, so an instance that's close to its deadline on
+// its own is already the one about to cause a dropout
+class CpuLoadMeter
+{
+public:
+    // A block that takes more than this share of its deadline counts as a near miss, one that takes longer than the
+    // whole deadline as a miss
+    static constexpr double nearMissThreshold = 0.8;
+
+    // How quickly the load follows the blocks, and how long the peak takes to fall back to a tenth of itself
+    static constexpr double loadSmoothingSeconds = 0.3;
+    static constexpr double peakDecaySeconds = 2.0;
+
+    // Clears everything measured so far. Call it while no blocks are being measured, e.g. from prepareToPlay
+    void prepare (double newSampleRate) noexcept;
+
+    // Times the block from its construction to its destruction. Audio thread only, never allocates or blocks.
+    // Blocks rendered without a deadline (offline bounces) aren't measured at all
+    class ScopedMeasurement
+    {
+    public:
+        ScopedMeasurement (CpuLoadMeter& meterToUse, int numSamplesInBlock, bool isRealtime) noexcept
+            : meter (isRealtime ? &meterToUse : nullptr),
+              numSamples (numSamplesInBlock),
+              start (meter != nullptr ? juce::Time::getHighResolutionTicks() : 0)
+        {
+        }
+
+        ~ScopedMeasurement() noexcept
+        {
+            if (meter != nullptr)
+                meter->addBlock (numSamples, juce::Time::highResolutionTicksToSeconds (juce::Time::getHighResolutionTicks() - start));
+        }
+
+    private:
+        CpuLoadMeter* meter;
+        int numSamples;
+        juce::int64 start;
+
+        JUCE_DECLARE_NON_COPYABLE (ScopedMeasurement)
+    };
+
+    // Adds one block that took elapsedSeconds to render. Audio thread only
+    void addBlock (int numSamples, double elapsedSeconds) noexcept;
+
+    // Safe to call from any thread. The loads are proportions of the deadline, so 1 means a block took as long as it lasts
+    float getLoad() const noexcept                      { return load.load (std::memory_order_relaxed); }
+    float getPeakLoad() const noexcept                  { return peakLoad.load (std::memory_order_relaxed); }
+    juce::uint32 getNumNearMisses() const noexcept      { return numNearMisses.load (std::memory_order_relaxed); }
+    juce::uint32 getNumMisses() const noexcept          { return numMisses.load (std::memory_order_relaxed); }
+
+private:
+    double sampleRate { 0.0 };
+
+    // The audio thread's own copies, so it never has to read the atomics back
+    double smoothedLoad { 0.0 };
+    double heldPeak { 0.0 };
+
+    std::atomic<float> load { 0.0f };
+    std::atomic<float> peakLoad { 0.0f };
+    std::atomic<juce::uint32> numNearMisses { 0 };
+    std::atomic<juce::uint32> numMisses { 0 };
+};
@@ -10,12 +10,168 @@
 
 #include "AdsrData.h"
 
-void AdsrData::updateADSR(const float attack, const float decay, const float sustain, const float release)
+void AdsrData::setSampleRate(double newSampleRate) noexcept
 {
-    adsrParams.attack = attack;
-    adsrParams.decay = decay;
-    adsrParams.sustain = sustain;
-    adsrParams.release = release;
+    sampleRate = newSampleRate;
+    updateADSR(attackSeconds, decaySeconds, sustainLevel, releaseSeconds);
+}
+
+void AdsrData::updateADSR(const float attack, const float decay, const float sustain, const float release) noexcept
+{
+    attackSeconds = attack;
+    decaySeconds = decay;
+    sustainLevel = juce::jlimit(0.0f, 1.0f, sustain);
+    releaseSeconds = release;
+    
+    // The attack and decay always span the same levels, so their curves only change with the parameters.
+    // The release starts from wherever the note is let go, so its curve is worked out then
+    attackCoefficient = getCoefficient(0.0f, 1.0f, 1.0f + attackOvershoot, getSamples(attackSeconds));
+    decayCoefficient = getCoefficient(1.0f, sustainLevel, sustainLevel - decayOvershoot, getSamples(decaySeconds));
+    
+    // A segment that's under way carries on from its current level along the new curve
+    if(segment != Segment::idle)
+        startSegment(segment);
+}
+
+void AdsrData::noteOn() noexcept
+{
+    startSegment(Segment::attack);
+}
+
+void AdsrData::noteOff() noexcept
+{
+    if(segment != Segment::idle)
+        startSegment(Segment::release);
+}
+
+void AdsrData::reset() noexcept
+{
+    segment = Segment::idle;
+    level = 0.0f;
+    curveRemaining = 0;
+}
+
+void AdsrData::process(float* values, int numSamples) noexcept
+{
+    for(int i = 0; i < numSamples;){
+        if(segment == Segment::idle || segment == Segment::sustain){
+            // Nothing changes until the next note on or off, so the rest of the block is one value
+            juce::FloatVectorOperations::fill(values + i, level, numSamples - i);
+            return;
+        }
+        
+        const auto length = juce::jmin(numSamples - i, curveRemaining);
+        renderCurve(values + i, length);
+        curveRemaining -= length;
+        i += length;
+        
+        if(curveRemaining == 0){
+            // Land exactly on the segment's end level, whatever rounding the curve picked up on the way
+            level = curveEnd;
+            values[i - 1] = level;
+            
+            switch(segment){
+                case Segment::attack:   startSegment(Segment::decay); break;
+                case Segment::decay:    startSegment(Segment::sustain); break;
+                case Segment::release:  startSegment(Segment::idle); break;
+                default:                break;
+            }
+        }
+    }
+}
+
+void AdsrData::renderCurve(float* values, int numSamples) noexcept
+{
+    // Closed form within each run, and one multiply carries the curve on to the next run
+    const auto* power = powers.data();
+    
+    for(int start = 0; start < numSamples; start += runLength){
+        const auto length = juce::jmin(runLength, numSamples - start);
+        auto* run = values + start;
+        
+        for(int s = 0; s < length; ++s)
+            run[s] = curveTarget + curveOffset * power[s];
+        
+        curveOffset *= power[length - 1];
+    }
     
-    setParameters(adsrParams);
+    level = curveTarget + curveOffset;
+}
+
+void AdsrData::startSegment(Segment newSegment) noexcept
+{
+    segment = newSegment;
+    
+    switch(segment){
+        case Segment::idle:
+            level = 0.0f;
+            curveRemaining = 0;
+            return;
+            
+        case Segment::sustain:
+            level = sustainLevel;
+            curveRemaining = 0;
+            return;
+            
+        case Segment::attack:
+            setCurve(1.0f, 1.0f + attackOvershoot, attackCoefficient);
+            break;
+            
+        case Segment::decay:
+            setCurve(sustainLevel, sustainLevel - decayOvershoot, decayCoefficient);
+            break;
+            
+        case Segment::release:
+            // Released notes take the release time to die away from whatever level they were at
+            setCurve(0.0f, -releaseOvershoot, getCoefficient(level, 0.0f, -releaseOvershoot, getSamples(releaseSeconds)));
+            break;
+    }
+    
+    // A segment with nothing to do (a decay to a sustain of 1, say) hands straight over to the next one
+    if(curveRemaining == 0){
+        level = curveEnd;
+        
+        switch(segment){
+            case Segment::attack:   startSegment(Segment::decay); break;
+            case Segment::decay:    startSegment(Segment::sustain); break;
+            case Segment::release:  startSegment(Segment::idle); break;
+            default:                break;
+        }
+    }
+}
+
+void AdsrData::setCurve(float endLevel, float target, float coefficient) noexcept
+{
+    curveEnd = endLevel;
+    curveTarget = target;
+    curveOffset = level - target;
+    curveRemaining = 0;
+    
+    // The number of samples left follows from how far the curve still has to go, so a segment that starts partway
+    // (a note on during a release, or new parameters) keeps the same shape and speed and just has less of it to do.
+    // It's rounded rather than rounded up, or the limited precision of the coefficient could add a sample to a whole segment
+    const auto remainingRatio = (endLevel - target) / (level - target);
+    
+    if(coefficient > 0.0f && coefficient < 1.0f && remainingRatio > 0.0f && remainingRatio < 1.0f)
+        curveRemaining = juce::jmax(1, juce::roundToInt(std::log((double) remainingRatio) / std::log((double) coefficient)));
+    
+    auto power = 1.0f;
+    
+    for(auto& p : powers)
+        p = power *= coefficient;
+}
+
+float AdsrData::getCoefficient(float startLevel, float endLevel, float target, int numSamples) noexcept
+{
+    const auto ratio = (endLevel - target) / (startLevel - target);
+    
+    if(ratio <= 0.0f || ratio >= 1.0f)
+        return 0.0f;
+    
+    return (float) std::pow((double) ratio, 1.0 / (double) numSamples);
+}
+
+int AdsrData::getSamples(double seconds) const noexcept
+{
+    return juce::jmax(1, juce::roundToInt(seconds * sampleRate));
 }
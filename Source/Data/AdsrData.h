@@ -11,12 +11,71 @@
 #pragma once
 #include <JuceHeader.h>
 
-class AdsrData : public juce::ADSR
+// Our envelope generator, used for both the amp and the mod envelope of every voice.
+// It works in segments (attack, decay, sustain, release) with exponential curves, and renders whole blocks of gain values:
+// each curve approaches a target just past the level it ends on, so it's target + offset * c^n, and the segment's length is
+// worked out when it starts. Within a run of up to runLength samples every value comes straight from a table of powers of c,
+// with nothing carried from one sample to the next, so the compiler vectorises it. Sustain and silence are plain fills.
+// The times are how long each segment takes from one end to the other, like juce::ADSR's
+class AdsrData
 {
 public:
-    void updateADSR(const float attack, const float decay, const float sustain, const float release);
-
+    void setSampleRate(double newSampleRate) noexcept;
+    void updateADSR(const float attack, const float decay, const float sustain, const float release) noexcept;
+    
+    // A note on while the envelope is still going carries on from its current level
+    void noteOn() noexcept;
+    void noteOff() noexcept;
+    void reset() noexcept;
+    
+    bool isActive() const noexcept { return segment != Segment::idle; }
+    bool isReleasing() const noexcept { return segment == Segment::release; }
+    
+    // The last value the envelope produced, which the voice stealing compares
+    float getLevel() const noexcept { return level; }
+    
+    // Writes the envelope's next numSamples values
+    void process(float* values, int numSamples) noexcept;
     
 private:
-    juce::ADSR::Parameters adsrParams;
+    enum class Segment
+    {
+        idle,
+        attack,
+        decay,
+        sustain,
+        release
+    };
+    
+    static constexpr int runLength = 16;
+    
+    // How far past the end of each segment its curve is aimed, as a fraction of full scale.
+    // The attack is only gently curved, the decay and release fall away quickly like an analogue envelope's
+    static constexpr float attackOvershoot = 0.3f;
+    static constexpr float decayOvershoot = 0.0001f;
+    static constexpr float releaseOvershoot = 0.0001f;
+    
+    void startSegment(Segment newSegment) noexcept;
+    void setCurve(float endLevel, float target, float coefficient) noexcept;
+    void renderCurve(float* values, int numSamples) noexcept;
+    
+    // The per sample coefficient of a curve from startLevel that reaches endLevel after numSamples
+    static float getCoefficient(float startLevel, float endLevel, float target, int numSamples) noexcept;
+    int getSamples(double seconds) const noexcept;
+    
+    double sampleRate { 44100.0 };
+    float attackSeconds { 0.1f }, decaySeconds { 0.1f }, sustainLevel { 1.0f }, releaseSeconds { 0.1f };
+    float attackCoefficient { 0.0f }, decayCoefficient { 0.0f };
+    
+    Segment segment { Segment::idle };
+    float level { 0.0f };
+    
+    // The current curve: where it's heading, where it ends, how far it is from its target and how many samples it has left
+    float curveTarget { 0.0f };
+    float curveEnd { 0.0f };
+    float curveOffset { 0.0f };
+    int curveRemaining { 0 };
+    
+    // c^1 to c^runLength for the current curve
+    std::array<float, (size_t) runLength> powers {};
 };
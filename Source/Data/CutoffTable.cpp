@@ -0,0 +1,25 @@
+/*
+  ==============================================================================
+
+    CutoffTable.cpp
+    Created: 18 Oct 2026 2:05:17am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "CutoffTable.h"
+
+const CutoffTable& CutoffTable::getInstance()
+{
+    // A function-local static is built exactly once, even if several instances prepare at the same time
+    static const CutoffTable cutoffTable;
+    return cutoffTable;
+}
+
+CutoffTable::CutoffTable()
+    : table ((size_t) tableSize + 1)
+{
+    for (int i = 0; i <= tableSize; ++i)
+        table[(size_t) i] = (float) std::tan (maxOmega * i / tableSize);
+}
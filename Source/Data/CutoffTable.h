@@ -0,0 +1,46 @@
+/*
+  ==============================================================================
+
+    CutoffTable.h
+    Created: 18 Oct 2026 2:05:17am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// tan() of the filter cutoff, which is the g coefficient of every filter model, as a linearly interpolated table.
+// It's indexed by the cutoff relative to the sample rate (omega = pi * cutoff / sampleRate), so one table covers every rate
+// and is built once and shared by every voice of every instance. Reads stay within 4e-5 of tan(), relative, all the way up to the
+// filters' limit just below Nyquist, where tan() gets steep
+class CutoffTable
+{
+public:
+    // The filters keep their cutoff below 0.49 times the sample rate, and the table stops there too
+    static constexpr double maxOmega = juce::MathConstants<double>::pi * 0.49;
+    static constexpr int tableSize = 4096;
+
+    // Builds the table on first use, which the filters do from prepareToPlay rather than on the audio thread
+    static const CutoffTable& getInstance();
+
+    // tan (omega), for omega in [0, maxOmega]. Anything outside is clamped to the range
+    float getG (float omega) const noexcept
+    {
+        const auto position = juce::jlimit (0.0f, (float) tableSize, omega * indexScale);
+        const auto index = juce::jmin ((int) position, tableSize - 1);
+        const auto fraction = position - (float) index;
+        return table[(size_t) index] + fraction * (table[(size_t) index + 1] - table[(size_t) index]);
+    }
+
+private:
+    CutoffTable();
+
+    static constexpr float indexScale = (float) (tableSize / maxOmega);
+
+    // tableSize + 1 points, so the last interval has its end point
+    std::vector<float> table;
+
+    JUCE_DECLARE_NON_COPYABLE (CutoffTable)
+};
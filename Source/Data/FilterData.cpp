@@ -9,50 +9,279 @@
 */
 
 #include "FilterData.h"
-void FilterData::prepareToPlay(double sampleRate, double samplesPerBlock, int numChannels){
-    filter.reset();
+void FilterData::prepareToPlay(double newSampleRate, double samplesPerBlock){
+    sampleRate = newSampleRate;
+    omegaPerHz = (float) (juce::MathConstants<double>::pi / sampleRate);
+    gValues.assign(juce::jmax((size_t) 1, (size_t) samplesPerBlock), 0.0f);
+    hValues.assign(gValues.size(), 1.0f);
+    dValues.assign(gValues.size(), 1.0f);
+    cutoffRamp.prepare(sampleRate);
+    resonanceRamp.prepare(sampleRate);
+    reset();
     
-    juce::dsp::ProcessSpec spec;
-    spec.maximumBlockSize = samplesPerBlock;
-    spec.sampleRate = sampleRate;
-    spec.numChannels = numChannels;
-    
-    filter.prepare(spec);
+    // The first filter to be prepared builds the table, everyone after that shares it
+    cutoffTable = &CutoffTable::getInstance();
     
     isPrepared = true;
 }
 
 
-void FilterData::process(juce::AudioBuffer<float>& buffer){
+void FilterData::setSampleRate(double newSampleRate) noexcept{
+    sampleRate = newSampleRate;
+    omegaPerHz = (float) (juce::MathConstants<double>::pi / sampleRate);
+    samplesToNextControlPoint = 0;
+    cutoffRamp.setSampleRate(newSampleRate);
+    resonanceRamp.setSampleRate(newSampleRate);
+}
+
+
+void FilterData::process(float* samples, int numSamples){
     
     jassert(isPrepared);
+    jassert(numSamples <= (int) gValues.size());
+    
+    const auto c = coefficients;
+    const auto* g = gValues.data();
+    const auto* h = hValues.data();
+    const auto* d = dValues.data();
+    auto s1 = state.s1;
+    auto s2 = state.s2;
+    auto s3 = state.s3;
+    auto s4 = state.s4;
     
-    juce::dsp::AudioBlock<float> block (buffer);
+    switch(c.topology){
+        case Topology::stateVariable:
+            for(int i = 0; i < numSamples; ++i){
+                const auto yHP = h[i] * (samples[i] - s1 * d[i] - s2);
+                
+                const auto yBP = yHP * g[i] + s1;
+                s1 = yHP * g[i] + yBP;
+                
+                const auto yLP = yBP * g[i] + s2;
+                s2 = yBP * g[i] + yLP;
+                
+                samples[i] = yLP * c.lowpassGain + yBP * c.bandpassGain + yHP * c.highpassGain;
+            }
+            break;
+            
+        case Topology::stateVariableCascade:
+            for(int i = 0; i < numSamples; ++i){
+                // Both stages are the same lowpass, so they share their coefficients
+                auto yHP = h[i] * (samples[i] - s1 * d[i] - s2);
+                auto yBP = yHP * g[i] + s1;
+                s1 = yHP * g[i] + yBP;
+                auto yLP = yBP * g[i] + s2;
+                s2 = yBP * g[i] + yLP;
+                
+                yHP = h[i] * (yLP - s3 * d[i] - s4);
+                yBP = yHP * g[i] + s3;
+                s3 = yHP * g[i] + yBP;
+                yLP = yBP * g[i] + s4;
+                s4 = yBP * g[i] + yLP;
+                
+                samples[i] = yLP;
+            }
+            break;
+            
+        case Topology::ladder:
+            for(int i = 0; i < numSamples; ++i){
+                // The four one-poles' contribution to the output that doesn't depend on this sample's input,
+                // which lets the feedback be solved for without a delay
+                const auto G = g[i];
+                const auto k = d[i];
+                const auto feedback = (1.0f - G) * (G * (G * (G * s1 + s2) + s3) + s4);
+                const auto u = (samples[i] - k * feedback) * h[i];
+                
+                auto v = (u - s1) * G;
+                auto y = v + s1;
+                s1 = y + v;
+                
+                v = (y - s2) * G;
+                y = v + s2;
+                s2 = y + v;
+                
+                v = (y - s3) * G;
+                y = v + s3;
+                s3 = y + v;
+                
+                v = (y - s4) * G;
+                y = v + s4;
+                s4 = y + v;
+                
+                // The feedback takes the passband down to 1 / (1 + k), this gives some of it back
+                samples[i] = y * (1.0f + 0.5f * k);
+            }
+            break;
+    }
     
-    filter.process(juce::dsp::ProcessContextReplacing<float>{block});
+    state.s1 = s1;
+    state.s2 = s2;
+    state.s3 = s3;
+    state.s4 = s4;
+}
+
+
+FilterData::Topology FilterData::getTopology(int filterType) noexcept{
+    switch (filterType) {
+        case lowpass24:     return Topology::stateVariableCascade;
+        case ladder:        return Topology::ladder;
+        default:            return Topology::stateVariable;
+    }
 }
 
 
-void FilterData::updateParameters(const int filterType, const float frequency, const float resonance, const float modulator){
+void FilterData::updateParameters(const int filterType, const float frequency, const float resonance){
+    // Switching between SVFs and the ladder would leave states and coefficients that mean something else, so the filter starts over
+    const auto topology = getTopology(filterType);
+    
+    if(topology != coefficients.topology){
+        coefficients.topology = topology;
+        reset();
+    }
+    
     switch (filterType) {
-        case 0:
-            filter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+        case bandpass:
+            // Band-Pass
+            coefficients.lowpassGain = 0.0f;
+            coefficients.bandpassGain = 1.0f;
+            coefficients.highpassGain = 0.0f;
             break;
-        case 1:
-            filter.setType(juce::dsp::StateVariableTPTFilterType::bandpass);
+        case highpass:
+            // High-Pass
+            coefficients.lowpassGain = 0.0f;
+            coefficients.bandpassGain = 0.0f;
+            coefficients.highpassGain = 1.0f;
             break;
-        case 2:
-            filter.setType(juce::dsp::StateVariableTPTFilterType::highpass);
+        default:
+            // Low-Pass, and the 4-pole models, which are lowpasses too
+            coefficients.lowpassGain = 1.0f;
+            coefficients.bandpassGain = 0.0f;
+            coefficients.highpassGain = 0.0f;
             break;
     }
-    float modFreq = std::fmax(frequency * modulator, 20.0f);
-    modFreq = std::fmax(modFreq, 20.0f);
-    modFreq = std::fmin(modFreq, 20000.0f);
     
-    filter.setCutoffFrequency(modFreq);
-    filter.setResonance(resonance);
+    // Both ramp to their new values, and the ramps are read at the control points, so a change glides in like the modulation does
+    cutoffRamp.setTargetValue(frequency);
+    resonanceRamp.setTargetValue(resonance);
+}
+
+void FilterData::skipParameterRamps() noexcept{
+    cutoffRamp.skipToTarget();
+    resonanceRamp.skipToTarget();
+}
+
+void FilterData::beginBlock(const float* modulation, int numSamples, CoefficientCache* sharedCache){
+    
+    jassert(isPrepared);
+    jassert(numSamples <= (int) gValues.size());
+    
+    auto& cache = sharedCache != nullptr ? *sharedCache : ownCache;
+    auto* g = gValues.data();
+    auto* h = hValues.data();
+    auto* d = dValues.data();
+    
+    for(int i = 0; i < numSamples;){
+        if(samplesToNextControlPoint == 0){
+            const auto modFreq = juce::jlimit(20.0f, 20000.0f, cutoffRamp.getValueAfter(i + 1) * modulation[i]);
+            
+            // The table stops just below Nyquist, which keeps the cutoff there at low sample rates
+            const auto omega = juce::jmin(modFreq * omegaPerHz, (float) CutoffTable::maxOmega);
+            
+            const auto& target = cache.get(omega, resonanceRamp.getValueAfter(i + 1), coefficients.topology, *cutoffTable);
+            targetG = target.g;
+            targetH = target.h;
+            targetD = target.d;
+            
+            // A voice that was just reset starts right at its cutoff instead of sweeping in from wherever the last note left it
+            if(snapToTarget){
+                currentG = targetG;
+                currentH = targetH;
+                currentD = targetD;
+                snapToTarget = false;
+            }
+            
+            gStep = (targetG - currentG) / (float) controlInterval;
+            hStep = (targetH - currentH) / (float) controlInterval;
+            dStep = (targetD - currentD) / (float) controlInterval;
+            samplesToNextControlPoint = controlInterval;
+        }
+        
+        // The control points are counted across blocks, so the result doesn't depend on the host's buffer size
+        const auto length = juce::jmin(samplesToNextControlPoint, numSamples - i);
+        
+        for(int s = 0; s < length; ++s){
+            g[i + s] = currentG + gStep * (float) (s + 1);
+            h[i + s] = currentH + hStep * (float) (s + 1);
+            d[i + s] = currentD + dStep * (float) (s + 1);
+        }
+        
+        samplesToNextControlPoint -= length;
+        i += length;
+        
+        if(samplesToNextControlPoint == 0){
+            currentG = targetG;
+            currentH = targetH;
+            currentD = targetD;
+        }
+        else{
+            currentG += gStep * (float) length;
+            currentH += hStep * (float) length;
+            currentD += dStep * (float) length;
+        }
+    }
+    
+    cutoffRamp.skip(numSamples);
+    resonanceRamp.skip(numSamples);
 }
 
 void FilterData::reset(){
-    filter.reset();
+    state = State();
+    
+    samplesToNextControlPoint = 0;
+    snapToTarget = true;
+}
+
+
+//==============================================================================
+const FilterData::CoefficientCache::Entry& FilterData::CoefficientCache::get(float omega, float resonance, Topology topology, const CutoffTable& cutoffTable) noexcept{
+    for(auto& entry : entries)
+        if(entry.omega == omega && entry.resonance == resonance && entry.topology == topology)
+            return entry;
+    
+    auto& entry = entries[(size_t) nextEntry];
+    nextEntry = (nextEntry + 1) % numEntries;
+    
+    entry.omega = omega;
+    entry.resonance = resonance;
+    entry.topology = topology;
+    
+    // Same coefficients as juce::dsp::StateVariableTPTFilter for the SVF, with tan (omega) read from the table
+    const auto g = cutoffTable.getG(omega);
+    
+    switch(topology){
+        case Topology::stateVariable:
+            entry.g = g;
+            entry.d = g + 1.0f / resonance;
+            entry.h = 1.0f / (1.0f + g * entry.d);
+            break;
+            
+        case Topology::stateVariableCascade:
+            // The two stages' peaks multiply, so each one gets the square root of the resonance
+            entry.g = g;
+            entry.d = g + 1.0f / std::sqrt(resonance);
+            entry.h = 1.0f / (1.0f + g * entry.d);
+            break;
+            
+        case Topology::ladder:
+        {
+            const auto G = g / (1.0f + g);
+            const auto G2 = G * G;
+            entry.g = G;
+            entry.d = 4.0f * (1.0f - 1.0f / resonance);
+            entry.h = 1.0f / (1.0f + entry.d * G2 * G2);
+            break;
+        }
+    }
+    
+    return entry;
 }
@@ -10,21 +10,130 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "LinearRamp.h"
+#include "CutoffTable.h"
 
-// This is our wrapper around the juce::dsp::StateVariableTPTFilter<float> class
+// Our filter. Its models all run on the same three per-sample coefficients (g, h and d, see getG) and four states,
+// and both are reachable from outside so the VoiceBatchRenderer's FilterBank can run several voices' filters side by side.
+// The state variable filter is the same topology-preserving transform SVF as juce::dsp::StateVariableTPTFilter<float>.
+// The cutoff follows a modulation signal (the mod envelope): a new target is worked out every controlInterval samples,
+// and the coefficients glide to it linearly in between. The targets come from the shared CutoffTable rather than tan(),
+// which makes the control points cheap enough to come every 8 samples.
+// Changes to the cutoff and resonance parameters ramp in over a few milliseconds and are picked up at the same control points
 class FilterData
 {
 public:
+    static constexpr int controlInterval = 8;
+    
+    // The FILTERTYPE choices, in the order of the parameter's list
+    enum Type
+    {
+        lowpass,
+        bandpass,
+        highpass,
+        lowpass24,          // two of the 2-pole lowpass SVFs in series, each with the square root of the resonance
+        ladder,             // a 4-pole zero-delay feedback ladder, linear, with feedback k = 4 (1 - 1 / resonance)
+        numTypes
+    };
+    
+    // How the coefficients and the state are used, which is all the filter bank needs to know to run a voice's filter
+    enum class Topology
+    {
+        stateVariable,
+        stateVariableCascade,
+        ladder
+    };
+    
+    static Topology getTopology(int filterType) noexcept;
+    
+    // The per-block coefficients, derived from the filter type in updateParameters
+    // The three mode gains pick the lowpass, bandpass or highpass output of the SVF without branching per sample
+    struct Coefficients
+    {
+        Topology topology { Topology::stateVariable };
+        float lowpassGain { 1.0f };
+        float bandpassGain { 0.0f };
+        float highpassGain { 0.0f };
+    };
+    
+    // The SVF's two integrators are s1 and s2, the cascade's second stage has s3 and s4, and the ladder's four one-poles use all of them
+    struct State
+    {
+        float s1 { 0.0f };
+        float s2 { 0.0f };
+        float s3 { 0.0f };
+        float s4 { 0.0f };
+    };
+    
+    // The control points of voices that share a cutoff, resonance and type (held notes at their sustain, mostly)
+    // come to the same coefficients. A cache shared by the voices that are rendered together works each of those out once.
+    // Keyed on the cutoff relative to the sample rate, so it stays valid when the rate changes
+    class CoefficientCache
+    {
+    public:
+        struct Entry
+        {
+            float omega { -1.0f };
+            float resonance { 0.0f };
+            Topology topology { Topology::stateVariable };
+            float g { 0.0f }, h { 1.0f }, d { 1.0f };
+        };
+        
+        const Entry& get(float omega, float resonance, Topology topology, const CutoffTable& cutoffTable) noexcept;
+        
+    private:
+        static constexpr int numEntries = 8;
+        std::array<Entry, (size_t) numEntries> entries {};
+        int nextEntry { 0 };
+    };
+    
     // Whenever we have some sort of dsp processing, we always need a prepareToPlay functionality
     // To pass the sample rate and buffer size to the algorithm
-    void prepareToPlay(double sampleRate, double samplesPerBlock, int numChannels);
-    void process(juce::AudioBuffer<float>& buffer);
-    void updateParameters(const int filterType, const float frequency, const float resonance, const float modulator = 1.0f);
+    // The filter is mono, like the voice that owns it
+    void prepareToPlay(double sampleRate, double samplesPerBlock);
+    
+    // Keeps the filter's state, the coefficients glide to the new rate's values from the next control point
+    void setSampleRate(double newSampleRate) noexcept;
+    void process(float* samples, int numSamples);
+    void updateParameters(const int filterType, const float frequency, const float resonance);
     void reset();
     
+    // Works out the coefficients g, h and d for every sample of the block, from one modulation value per sample
+    // that multiplies the cutoff. Must be called before process, with no more samples than prepareToPlay was given.
+    // Without a shared cache the filter uses its own, which still saves the work while the cutoff holds still
+    void beginBlock(const float* modulation, int numSamples, CoefficientCache* sharedCache = nullptr);
+    
+    // The cutoff and resonance glide to new values. A voice that starts a note from silence has no use for the glide
+    void skipParameterRamps() noexcept;
+    
+    // For the SVFs g is the integrators' gain, d is g + 2R (the damping, which follows the resonance) and h = 1 / (1 + g * d).
+    // For the ladder g is the one-poles' gain G = g / (1 + g), d is the feedback k and h = 1 / (1 + k * G^4)
+    const Coefficients& getCoefficients() const noexcept { return coefficients; }
+    const float* getG() const noexcept { return gValues.data(); }
+    const float* getH() const noexcept { return hValues.data(); }
+    const float* getD() const noexcept { return dValues.data(); }
+    State& getState() noexcept { return state; }
+    
 private:
     
-    juce::dsp::StateVariableTPTFilter<float> filter;
+    Coefficients coefficients;
+    State state;
+    CoefficientCache ownCache;
+    const CutoffTable* cutoffTable { nullptr };
+    double sampleRate { 44100.0 };
+    float omegaPerHz { juce::MathConstants<float>::pi / 44100.0f };
     bool isPrepared {false};
+    
+    LinearRamp cutoffRamp { 200.0f };
+    LinearRamp resonanceRamp { 1.0f };
+    
+    // Where the coefficients are on their way to the next control point, and how far they move per sample
+    float currentG { 0.0f }, currentH { 1.0f }, currentD { 1.0f };
+    float targetG { 0.0f }, targetH { 1.0f }, targetD { 1.0f };
+    float gStep { 0.0f }, hStep { 0.0f }, dStep { 0.0f };
+    int samplesToNextControlPoint { 0 };
+    bool snapToTarget { true };
+    
+    std::vector<float> gValues, hValues, dValues;
 
 };
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    LinearRamp.h
+    Created: 17 Oct 2026 10:21:54pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// A parameter value that glides to each new target over a fixed time instead of stepping, so automation doesn't zipper.
+// Unlike juce::SmoothedValue it's read a block at a time: process writes the ramp with a loop that carries nothing from one
+// sample to the next, so the compiler vectorises it, and once the target is reached callers can skip the ramp altogether
+class LinearRamp
+{
+public:
+    static constexpr double defaultRampSeconds = 0.02;
+
+    explicit LinearRamp (float initialValue = 0.0f) noexcept
+        : current (initialValue), target (initialValue)
+    {
+    }
+
+    // Sets the ramp time, and makes the next target take effect straight away rather than ramping in from wherever the value was
+    void prepare (double sampleRate, double rampSeconds = defaultRampSeconds) noexcept
+    {
+        seconds = juce::jmax (0.0, rampSeconds);
+        rampLength = juce::jmax (1, juce::roundToInt (sampleRate * seconds));
+        skipNextRamp = true;
+    }
+
+    // Keeps the value and any ramp under way, which carries on at the same speed in real time
+    void setSampleRate (double sampleRate) noexcept
+    {
+        const auto newRampLength = juce::jmax (1, juce::roundToInt (sampleRate * seconds));
+
+        if (remaining > 0)
+        {
+            remaining = juce::jmax (1, (int) ((juce::int64) remaining * newRampLength / rampLength));
+            step = (target - current) / (float) remaining;
+        }
+
+        rampLength = newRampLength;
+    }
+
+    void setTargetValue (float newTarget) noexcept
+    {
+        if (skipNextRamp)
+        {
+            skipNextRamp = false;
+            target = newTarget;
+            skipToTarget();
+            return;
+        }
+
+        if (newTarget == target)
+            return;
+
+        target = newTarget;
+        remaining = rampLength;
+        step = (target - current) / (float) rampLength;
+    }
+
+    void skipToTarget() noexcept
+    {
+        current = target;
+        remaining = 0;
+        step = 0.0f;
+    }
+
+    bool isRamping() const noexcept             { return remaining > 0; }
+    float getCurrentValue() const noexcept      { return current; }
+    float getTargetValue() const noexcept       { return target; }
+
+    // The value numSamples from now, without moving the ramp on
+    float getValueAfter (int numSamples) const noexcept
+    {
+        return numSamples >= remaining ? target : current + step * (float) numSamples;
+    }
+
+    // Writes the next numSamples values and moves the ramp on by that many samples
+    void process (float* values, int numSamples) noexcept
+    {
+        const auto numRampSamples = juce::jlimit (0, numSamples, remaining);
+
+        for (int i = 0; i < numRampSamples; ++i)
+            values[i] = current + step * (float) (i + 1);
+
+        juce::FloatVectorOperations::fill (values + numRampSamples, target, numSamples - numRampSamples);
+        skip (numSamples);
+    }
+
+    void skip (int numSamples) noexcept
+    {
+        if (numSamples >= remaining)
+        {
+            skipToTarget();
+        }
+        else
+        {
+            current += step * (float) numSamples;
+            remaining -= numSamples;
+        }
+    }
+
+private:
+    float current { 0.0f }, target { 0.0f }, step { 0.0f };
+    int remaining { 0 };
+    int rampLength { 1 };
+    double seconds { defaultRampSeconds };
+    bool skipNextRamp { true };
+};
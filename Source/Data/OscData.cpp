@@ -11,25 +11,41 @@
 #include "OscData.h"
 
 void OscData::prepareToPlay(juce::dsp::ProcessSpec& spec){
-    fmOsc.prepare(spec);
-    prepare(spec);
+    increments.assign(juce::jmax((size_t) 1, (size_t) spec.maximumBlockSize), 0.0f);
+    modPhases.assign(increments.size(), 0.0f);
+    modDepths.assign(increments.size(), 0.0f);
+    fmPhase = 0.0f;
+    fmFrequency.prepare(spec.sampleRate);
+    fmDepth.prepare(spec.sampleRate);
+    
+    // The first oscillator to be prepared builds the band-limited tables, everyone after that shares them
+    wavetables = &WavetableBank::getInstance();
+    sampleRate = spec.sampleRate;
+    phase = 0.0f;
+}
+
+void OscData::setSampleRate(double newSampleRate) noexcept{
+    sampleRate = newSampleRate;
+    fmFrequency.setSampleRate(newSampleRate);
+    fmDepth.setSampleRate(newSampleRate);
 }
 
 void OscData::setWaveType(const int choice){
+    // Switching waveform is just a matter of reading from different tables, nothing is rebuilt or allocated
     switch (choice) {
         case 0:
             // Sine Wave
-            initialise([](float x) {return sin(x);});
+            waveType = WavetableBank::sine;
             break;
             
         case 1:
             // Saw Wave
-            initialise([](float x) {return x / juce::MathConstants<float>::pi;});
+            waveType = WavetableBank::saw;
             break;
             
         case 2:
             // Square Wave
-            initialise([](float x) {return x < 0.0f ? -1.0f : 1.0f;});
+            waveType = WavetableBank::square;
             break;
             
         default:
@@ -39,31 +55,130 @@ void OscData::setWaveType(const int choice){
 }
 
 void OscData::setWaveFrequency(const int midiNoteNumber){
-    // Notice how we are adding fmMod, which is a sample value, to the main wave frequency
-    setFrequency(juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber) + fmMod);
-    lastMidiNoteNumber = midiNoteNumber;
+    // The FM is added on top of this on every sample in beginBlock
+    frequency = (float) juce::MidiMessage::getMidiNoteInHertz (midiNoteNumber);
+}
+
+OscData::BlockSetup OscData::beginBlock (int numSamples){
+    
+    jassert(wavetables != nullptr);
+    jassert(numSamples <= (int) increments.size());
+    
+    const auto samplePeriod = (float) (1.0 / sampleRate);
+    const auto baseIncrement = frequency * samplePeriod;
+    auto* increment = increments.data();
+    
+    // Choose the mip level for the highest frequency the FM can reach, so no harmonic in the table ends up above Nyquist.
+    // The depth ramps linearly, so its largest value in the block is at one end or the other
+    const auto maxDepth = juce::jmax(fmDepth.getCurrentValue(), fmDepth.getValueAfter(numSamples));
+    const auto maxIncrement = juce::jmin(0.5f, std::abs(baseIncrement) + maxDepth * samplePeriod);
+    
+    if(maxDepth == 0.0f){
+        juce::FloatVectorOperations::fill(increment, baseIncrement, numSamples);
+        fmFrequency.skip(numSamples);
+        fmDepth.skip(numSamples);
+    }
+    else{
+        auto* modPhase = modPhases.data();
+        auto* modDepth = modDepths.data();
+        
+        if(fmFrequency.isRamping()){
+            // While the modulator's frequency glides its phase has to be accumulated, but that's only for the length of the ramp
+            fmFrequency.process(modPhase, numSamples);
+            
+            for(int s = 0; s < numSamples; ++s){
+                const auto modIncrement = modPhase[s] * samplePeriod;
+                modPhase[s] = fmPhase;
+                fmPhase += modIncrement;
+            }
+        }
+        else{
+            // Otherwise the modulator's phase on each sample is worked out from the start of the block rather than accumulated,
+            // so nothing carries over from one iteration to the next and the compiler can vectorise this loop
+            const auto fmIncrement = fmFrequency.getTargetValue() * samplePeriod;
+            
+            for(int s = 0; s < numSamples; ++s)
+                modPhase[s] = fmPhase + (float) s * fmIncrement;
+            
+            fmPhase += (float) numSamples * fmIncrement;
+        }
+        
+        fmPhase -= (float) (int) fmPhase;
+        fmDepth.process(modDepth, numSamples);
+        
+        for(int s = 0; s < numSamples; ++s){
+            // Centre it on zero, FastMathApproximations::sin is only accurate between -pi and pi
+            const auto centredPhase = modPhase[s] - (float) (int) (modPhase[s] + 0.5f);
+            
+            const auto modulator = juce::dsp::FastMathApproximations<float>::sin(juce::MathConstants<float>::twoPi * centredPhase);
+            increment[s] = juce::jlimit(-0.5f, 0.5f, baseIncrement + modDepth[s] * samplePeriod * modulator);
+        }
+    }
+    
+    // The blend between mip levels moves from where the last block left it to where this one needs it, over the block.
+    // Both ends are read from the same pair of levels, the pair the higher end needs. An end below that pair plays the pair's
+    // lower level, which has no more harmonics than that end would have had, so the change of pair never adds aliasing
+    const auto endPosition = WavetableBank::getLevelPosition(maxIncrement);
+    const auto startPosition = levelPosition < 0.0f ? endPosition : levelPosition;
+    levelPosition = endPosition;
+    
+    auto level = juce::jmin((int) juce::jmax(startPosition, endPosition), WavetableBank::numLevels - 2);
+    auto startMix = juce::jlimit(0.0f, 1.0f, startPosition - (float) level);
+    auto endMix = juce::jlimit(0.0f, 1.0f, endPosition - (float) level);
+    
+    // At the top of the range a note can sit right on the next level, which is then all that's read
+    if(startMix == 1.0f && endMix == 1.0f){
+        ++level;
+        startMix = endMix = 0.0f;
+    }
+    
+    return { wavetables->getTable(waveType, level),
+             wavetables->getTable(waveType, juce::jmin(level + 1, WavetableBank::numLevels - 1)),
+             startMix, (endMix - startMix) / (float) juce::jmax(1, numSamples), increment };
 }
 
 void OscData::getNextAudioBlock (juce::dsp::AudioBlock<float>& block){
     
-    // Perform sample by sample processing (rather than the entire buffer) for the fm wave
-    // We can do this with the processSample method 
-    for(int channel = 0; channel < block.getNumChannels(); ++channel){
-        for(int s = 0; s < block.getNumSamples(); ++s){
-            fmMod = fmOsc.processSample(block.getSample(channel, s)) * fmDepth;
+    const auto numSamples = (int) block.getNumSamples();
+    
+    // Every channel gets the same waveform, so we render it once and copy it to the others
+    auto* firstChannel = block.getChannelPointer(0);
+    render(beginBlock(numSamples), firstChannel, numSamples);
+    
+    for(size_t channel = 1; channel < block.getNumChannels(); ++channel)
+        juce::FloatVectorOperations::copy(block.getChannelPointer(channel), firstChannel, numSamples);
+}
+
+void OscData::render (const BlockSetup& setup, float* samples, int numSamples) noexcept{
+    if(! setup.isBlending()){
+        for(int s = 0; s < numSamples; ++s){
+            samples[s] = WavetableBank::read(setup.table, phase);
+            phase = wrapPhase(phase + setup.increments[s]);
         }
+        
+        return;
     }
     
-    process(juce::dsp::ProcessContextReplacing<float>(block));
+    auto mix = setup.mix;
+    
+    for(int s = 0; s < numSamples; ++s){
+        const auto lower = WavetableBank::read(setup.table, phase);
+        samples[s] = lower + mix * (WavetableBank::read(setup.nextTable, phase) - lower);
+        mix += setup.mixIncrement;
+        phase = wrapPhase(phase + setup.increments[s]);
+    }
 }
 
 void OscData::setFmParams (const float freq, const float depth){
     // Set the fm waveform frequency and depth here
-    fmOsc.setFrequency(freq);
-    fmDepth = depth;
-    
-    // Set the main waveform frequency here (as influenced by the fm waveform)
-    // The phase increment cannot be negative, so we esure that here
-    auto currentFreq = abs(juce::MidiMessage::getMidiNoteInHertz (lastMidiNoteNumber) + fmMod);
-    setFrequency(currentFreq);
+    // This is only called when the parameters change, the fm wave is applied to the main waveform sample by sample in beginBlock
+    // Both glide to their new values rather than jumping, a jump in depth is heard as a click
+    fmFrequency.setTargetValue(freq);
+    fmDepth.setTargetValue(depth);
+}
+
+void OscData::skipParameterRamps() noexcept{
+    fmFrequency.skipToTarget();
+    fmDepth.skipToTarget();
+    levelPosition = -1.0f;
 }
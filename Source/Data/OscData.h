@@ -10,24 +10,91 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include "WavetableBank.h"
+#include "LinearRamp.h"
 
-class OscData : public juce::dsp::Oscillator<float>
+// Our main oscillator. It reads band-limited waveforms from the shared WavetableBank, so Saw and Square don't alias
+class OscData
 {
 public:
     void prepareToPlay(juce::dsp::ProcessSpec& spec);
+    
+    // Changes the rate without touching the phase, so a playing note carries on at the new rate
+    void setSampleRate(double newSampleRate) noexcept;
     void setWaveType(const int choice);
     void setWaveFrequency(const int midiNoteNumber);
     void getNextAudioBlock (juce::dsp::AudioBlock<float>& block);
     void setFmParams (const float freq, const float depth);
     
+    // The FM parameters glide to new values, and so does the blend between mip levels. A voice that starts a note from silence
+    // has no use for the glide
+    void skipParameterRamps() noexcept;
+    
+    // What the oscillator needs to render one block: the mip level to read from, the next level up and how far to blend
+    // towards it (moving by mixIncrement on each sample), and how far the phase moves on each sample.
+    // Away from the boundary between two levels mix and mixIncrement are both 0, and nextTable doesn't have to be read
+    struct BlockSetup
+    {
+        const float* table;
+        const float* nextTable;
+        float mix;
+        float mixIncrement;
+        const float* increments;
+        
+        bool isBlending() const noexcept { return mix != 0.0f || mixIncrement != 0.0f; }
+    };
+    
+    // Runs the FM modulator over the block and turns it into per-sample phase increments for the carrier, then picks the tables.
+    // numSamples must not be more than the block size given to prepareToPlay.
+    // getNextAudioBlock calls this itself, the VoiceBatchRenderer calls it and then runs the phase of several voices together
+    BlockSetup beginBlock (int numSamples);
+    
+    // Reads numSamples of the waveform into samples with the increments beginBlock worked out, and moves the phase on
+    void render (const BlockSetup& setup, float* samples, int numSamples) noexcept;
+    
+    float getPhase() const noexcept { return phase; }
+    void setPhase (float newPhase) noexcept { phase = newPhase; }
+    
+    // Back to the start of the cycle, for the FM modulator as well as the carrier
+    void reset() noexcept { phase = 0.0f; fmPhase = 0.0f; levelPosition = -1.0f; }
+    
+    // Keeps a phase within [0, 1) after it moved by at most half a cycle in either direction.
+    // A phase a hair below zero rounds to exactly 1 when it's wrapped, and that has to come back to 0
+    static float wrapPhase (float newPhase) noexcept
+    {
+        if(newPhase >= 1.0f) return newPhase - 1.0f;
+        
+        if(newPhase < 0.0f){
+            newPhase += 1.0f;
+            return newPhase < 1.0f ? newPhase : 0.0f;
+        }
+        
+        return newPhase;
+    }
+    
 private:
-    // Create oscillator for FM modulation 
-    juce::dsp::Oscillator<float> fmOsc {[](float x) {return sin(x);}};
-    float fmMod {0.0f};
-    // We create fmDepth here to scale the gain as the juce::dsp::Oscillator<float> fmOsc object does not have a set gain method for the entire oscillator
-    // So we create this float value and multiply it to our sample value when we do sample by sample processing
-    float fmDepth {0.0f};
-    
-    int lastMidiNoteNumber { 0 };
+    // The band-limited tables, shared by every voice. Set up in prepareToPlay
+    const WavetableBank* wavetables { nullptr };
+    int waveType { WavetableBank::sine };
+    double sampleRate { 44100.0 };
+    
+    // Position within the current cycle, from 0 to 1
+    float phase { 0.0f };
+    float frequency { 0.0f };
+    
+    // The WavetableBank::getLevelPosition the last block ended at, which the next one blends on from.
+    // Negative when there's nothing to blend from, and then a block starts where it ends
+    float levelPosition { -1.0f };
+    
+    // The FM modulator is a sine that moves the carrier's frequency by up to fmDepth Hz on every sample
+    LinearRamp fmFrequency;
+    LinearRamp fmDepth;
+    float fmPhase { 0.0f };
+    
+    // The carrier's phase increment for every sample of the current block, and the modulator's phase and depth
+    // that go into it. Sized in prepareToPlay
+    std::vector<float> increments;
+    std::vector<float> modPhases;
+    std::vector<float> modDepths;
     
 };
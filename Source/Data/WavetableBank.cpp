@@ -0,0 +1,86 @@
+/*
+  ==============================================================================
+
+    WavetableBank.cpp
+    Created: 17 Oct 2026 2:41:33pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "WavetableBank.h"
+
+const WavetableBank& WavetableBank::getInstance()
+{
+    // A function-local static is built exactly once, even if several instances prepare at the same time
+    static const WavetableBank bank;
+    return bank;
+}
+
+WavetableBank::WavetableBank()
+    : tables ((size_t) (numWaveforms * numLevels * samplesPerTable), 0.0f)
+{
+    // One cycle of a sine, used to look up every harmonic: sin(2 pi k i / N) is sineCycle[(k * i) mod N]
+    std::vector<double> sineCycle ((size_t) tableSize);
+
+    for (int i = 0; i < tableSize; ++i)
+        sineCycle[(size_t) i] = std::sin (juce::MathConstants<double>::twoPi * i / tableSize);
+
+    std::vector<double> sum ((size_t) tableSize);
+
+    for (int waveform = 0; waveform < numWaveforms; ++waveform)
+    {
+        for (int level = 0; level < numLevels; ++level)
+        {
+            const auto numHarmonics = (tableSize / 2) >> level;
+            std::fill (sum.begin(), sum.end(), 0.0);
+
+            // These are the Fourier series of the shapes the oscillator always had for a phase p in [0, 1):
+            // sine is -sin(2 pi p), saw rises from -1 to 1, square is -1 for the first half of the cycle and 1 for the second
+            for (int harmonic = 1; harmonic <= numHarmonics; ++harmonic)
+            {
+                double amplitude = 0.0;
+
+                switch (waveform)
+                {
+                    case sine:      amplitude = harmonic == 1 ? -1.0 : 0.0; break;
+                    case saw:       amplitude = -2.0 / (juce::MathConstants<double>::pi * harmonic); break;
+                    case square:    amplitude = harmonic % 2 == 1 ? -4.0 / (juce::MathConstants<double>::pi * harmonic) : 0.0; break;
+                    default:        jassertfalse; break;
+                }
+
+                if (amplitude == 0.0)
+                    continue;
+
+                for (int i = 0; i < tableSize; ++i)
+                    sum[(size_t) i] += amplitude * sineCycle[(size_t) ((harmonic * i) & (tableSize - 1))];
+            }
+
+            auto* table = tables.data() + (size_t) ((waveform * numLevels + level) * samplesPerTable);
+
+            for (int i = 0; i < tableSize; ++i)
+                table[i] = (float) sum[(size_t) i];
+
+            table[tableSize] = table[0];
+        }
+    }
+}
+
+const float* WavetableBank::getTable (int waveform, int level) const noexcept
+{
+    jassert (juce::isPositiveAndBelow (waveform, (int) numWaveforms));
+    jassert (juce::isPositiveAndBelow (level, numLevels));
+
+    return tables.data() + (size_t) ((waveform * numLevels + level) * samplesPerTable);
+}
+
+float WavetableBank::getLevelPosition (float phaseIncrement) noexcept
+{
+    // The highest harmonic at a level sits at harmonics * phaseIncrement cycles per sample, which has to stay at or below 0.5.
+    // Level 0 has tableSize / 2 harmonics, so the lowest level that doesn't alias is log2 (tableSize * phaseIncrement) rounded up
+    const auto octaves = std::log2 (juce::jmax ((float) tableSize * std::abs (phaseIncrement), 1.0e-6f));
+    const auto lowerLevel = std::floor (octaves) + 1.0f;
+    const auto fraction = octaves + 1.0f - lowerLevel;
+
+    return juce::jlimit (0.0f, (float) (numLevels - 1), lowerLevel + juce::jmax (0.0f, (fraction - (1.0f - fadeOctaves)) / fadeOctaves));
+}
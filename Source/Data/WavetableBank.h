@@ -0,0 +1,61 @@
+/*
+  ==============================================================================
+
+    WavetableBank.h
+    Created: 17 Oct 2026 2:41:33pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+// Single-cycle tables for each of the oscillator's waveforms, band-limited so they don't alias.
+// Every waveform has one mip level per octave: level 0 holds all the harmonics a table can represent,
+// and each level above it holds half as many, so a note can always pick a level whose highest harmonic is below Nyquist.
+// The tables don't depend on the sample rate, so a single bank is built once and shared by every voice of every instance.
+class WavetableBank
+{
+public:
+    enum Waveform
+    {
+        sine = 0,
+        saw,
+        square,
+        numWaveforms
+    };
+
+    // Samples per cycle. Each table stores one extra guard sample (a copy of the first) so interpolated reads never wrap
+    static constexpr int tableSize = 2048;
+    static constexpr int numLevels = 11;
+
+    // Builds the tables on first use, which the oscillators do from prepareToPlay rather than on the audio thread
+    static const WavetableBank& getInstance();
+
+    // Returns tableSize + 1 samples of the given waveform and mip level
+    const float* getTable (int waveform, int level) const noexcept;
+
+    // Where a phase increment (in cycles per sample) sits among the levels: a level, plus how far reads should be blended
+    // towards the next level up. Blending means a glide or an FM sweep moves from one level to the next without a step.
+    // Both levels of a blend stay below Nyquist, the blend only starts in the last fadeOctaves before the lower one would alias
+    static float getLevelPosition (float phaseIncrement) noexcept;
+    static constexpr float fadeOctaves = 0.25f;
+
+    // Linearly interpolated read, phase is in cycles and must be within [0, 1)
+    static float read (const float* table, float phase) noexcept
+    {
+        const auto position = phase * (float) tableSize;
+        const auto index = (int) position;
+        const auto fraction = position - (float) index;
+        return table[index] + fraction * (table[index + 1] - table[index]);
+    }
+
+private:
+    WavetableBank();
+
+    static constexpr int samplesPerTable = tableSize + 1;
+    std::vector<float> tables;
+
+    JUCE_DECLARE_NON_COPYABLE (WavetableBank)
+};
@@ -0,0 +1,220 @@
+/*
+  ==============================================================================
+
+    FilterBank.cpp
+    Created: 18 Oct 2026 12:52:31am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "FilterBank.h"
+
+#if JUCE_USE_SIMD
+namespace
+{
+    using Register = FilterBank::Register;
+
+    // The four states, structure-of-arrays across the lanes
+    struct LaneStates
+    {
+        Register s1, s2, s3, s4;
+
+        explicit LaneStates (FilterData* const* filters) noexcept
+        {
+            for (int lane = 0; lane < FilterBank::numLanes; ++lane)
+            {
+                const auto& state = filters[lane]->getState();
+                s1.set ((size_t) lane, state.s1);
+                s2.set ((size_t) lane, state.s2);
+                s3.set ((size_t) lane, state.s3);
+                s4.set ((size_t) lane, state.s4);
+            }
+        }
+
+        void store (FilterData* const* filters) const noexcept
+        {
+            for (int lane = 0; lane < FilterBank::numLanes; ++lane)
+            {
+                auto& state = filters[lane]->getState();
+                state.s1 = s1.get ((size_t) lane);
+                state.s2 = s2.get ((size_t) lane);
+                state.s3 = s3.get ((size_t) lane);
+                state.s4 = s4.get ((size_t) lane);
+            }
+        }
+    };
+}
+
+void FilterBank::prepare (int maximumBlockSize)
+{
+    gLanes.allocate (maximumBlockSize);
+    hLanes.allocate (maximumBlockSize);
+    dLanes.allocate (maximumBlockSize);
+    laneSamples.assign ((size_t) juce::jmax (1, maximumBlockSize), 0.0f);
+}
+
+void FilterBank::process (FilterData* const* filters, const LaneBuffer& samples, int numSamples)
+{
+    jassert (numSamples <= (int) laneSamples.size());
+
+    const auto topology = filters[0]->getCoefficients().topology;
+
+    for (int lane = 1; lane < numLanes; ++lane)
+    {
+        if (filters[lane]->getCoefficients().topology != topology)
+        {
+            processEachLane (filters, samples, numSamples);
+            return;
+        }
+    }
+
+    loadCoefficients (filters, numSamples);
+
+    switch (topology)
+    {
+        case FilterData::Topology::stateVariable:           processStateVariable (filters, samples, numSamples); break;
+        case FilterData::Topology::stateVariableCascade:    processStateVariableCascade (filters, samples, numSamples); break;
+        case FilterData::Topology::ladder:                  processLadder (filters, samples, numSamples); break;
+    }
+}
+
+void FilterBank::loadCoefficients (FilterData* const* filters, int numSamples) noexcept
+{
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        const auto* g = filters[lane]->getG();
+        const auto* h = filters[lane]->getH();
+        const auto* d = filters[lane]->getD();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            gLanes.getSample (i)[lane] = g[i];
+            hLanes.getSample (i)[lane] = h[i];
+            dLanes.getSample (i)[lane] = d[i];
+        }
+    }
+}
+
+void FilterBank::processStateVariable (FilterData* const* filters, const LaneBuffer& samples, int numSamples)
+{
+    // The mode gains are fixed for the block, g, h and d follow each voice's mod envelope and parameter ramps sample by sample
+    auto lowpassGain = Register::expand (0.0f), bandpassGain = Register::expand (0.0f), highpassGain = Register::expand (0.0f);
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        const auto& c = filters[lane]->getCoefficients();
+        lowpassGain.set ((size_t) lane, c.lowpassGain);
+        bandpassGain.set ((size_t) lane, c.bandpassGain);
+        highpassGain.set ((size_t) lane, c.highpassGain);
+    }
+
+    LaneStates states (filters);
+    auto s1 = states.s1, s2 = states.s2;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto g = gLanes.load (i), h = hLanes.load (i), d = dLanes.load (i);
+
+        const auto yHP = h * (samples.load (i) - s1 * d - s2);
+
+        const auto yBP = yHP * g + s1;
+        s1 = yHP * g + yBP;
+
+        const auto yLP = yBP * g + s2;
+        s2 = yBP * g + yLP;
+
+        samples.store (i, yLP * lowpassGain + yBP * bandpassGain + yHP * highpassGain);
+    }
+
+    states.s1 = s1;
+    states.s2 = s2;
+    states.store (filters);
+}
+
+void FilterBank::processStateVariableCascade (FilterData* const* filters, const LaneBuffer& samples, int numSamples)
+{
+    LaneStates states (filters);
+    auto s1 = states.s1, s2 = states.s2, s3 = states.s3, s4 = states.s4;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto g = gLanes.load (i), h = hLanes.load (i), d = dLanes.load (i);
+
+        auto yHP = h * (samples.load (i) - s1 * d - s2);
+        auto yBP = yHP * g + s1;
+        s1 = yHP * g + yBP;
+        auto yLP = yBP * g + s2;
+        s2 = yBP * g + yLP;
+
+        yHP = h * (yLP - s3 * d - s4);
+        yBP = yHP * g + s3;
+        s3 = yHP * g + yBP;
+        yLP = yBP * g + s4;
+        s4 = yBP * g + yLP;
+
+        samples.store (i, yLP);
+    }
+
+    states.s1 = s1;
+    states.s2 = s2;
+    states.s3 = s3;
+    states.s4 = s4;
+    states.store (filters);
+}
+
+void FilterBank::processLadder (FilterData* const* filters, const LaneBuffer& samples, int numSamples)
+{
+    // The same zero-delay feedback solution as FilterData::process, with G in g, k in d and 1 / (1 + k * G^4) in h
+    LaneStates states (filters);
+    auto s1 = states.s1, s2 = states.s2, s3 = states.s3, s4 = states.s4;
+    const auto one = Register::expand (1.0f);
+    const auto half = Register::expand (0.5f);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const auto G = gLanes.load (i), h = hLanes.load (i), k = dLanes.load (i);
+
+        const auto feedback = (one - G) * (G * (G * (G * s1 + s2) + s3) + s4);
+        const auto u = (samples.load (i) - k * feedback) * h;
+
+        auto v = (u - s1) * G;
+        auto y = v + s1;
+        s1 = y + v;
+
+        v = (y - s2) * G;
+        y = v + s2;
+        s2 = y + v;
+
+        v = (y - s3) * G;
+        y = v + s3;
+        s3 = y + v;
+
+        v = (y - s4) * G;
+        y = v + s4;
+        s4 = y + v;
+
+        samples.store (i, y * (one + half * k));
+    }
+
+    states.s1 = s1;
+    states.s2 = s2;
+    states.s3 = s3;
+    states.s4 = s4;
+    states.store (filters);
+}
+
+void FilterBank::processEachLane (FilterData* const* filters, const LaneBuffer& samples, int numSamples)
+{
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            laneSamples[(size_t) i] = samples.getSample (i)[lane];
+
+        filters[lane]->process (laneSamples.data(), numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+            samples.getSample (i)[lane] = laneSamples[(size_t) i];
+    }
+}
+#endif
@@ -0,0 +1,76 @@
+/*
+  ==============================================================================
+
+    FilterBank.h
+    Created: 18 Oct 2026 12:52:31am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "FilterData.h"
+
+#if JUCE_USE_SIMD
+// Runs the filters of a group of voices together, one voice per lane of a juce::dsp::SIMDRegister<float>.
+// For the group's block the states of every voice's filter are held structure-of-arrays, one register per state variable,
+// and go back to the voices' FilterData afterwards, since a voice can be rendered in a different group (or on its own) next time.
+// It also holds the coefficient cache that the voices it renders share, so voices with the same cutoff work it out once
+class FilterBank
+{
+public:
+    using Register = juce::dsp::SIMDRegister<float>;
+    static constexpr int numLanes = (int) Register::SIMDNumElements;
+
+    // A block of samples for every lane, interleaved: numLanes floats per sample, lane i of sample s at getSample (s)[i].
+    // Each sample starts on a SIMD boundary so it loads into a Register in one go, and a lane's column is filled with
+    // plain float stores rather than a Register::set per sample
+    class LaneBuffer
+    {
+    public:
+        LaneBuffer() = default;
+
+        void allocate (int numSamples)
+        {
+            storage.assign ((size_t) ((juce::jmax (1, numSamples) + 1) * numLanes), 0.0f);
+            data = Register::getNextSIMDAlignedPtr (storage.data());
+        }
+
+        float* getSample (int i) const noexcept                 { return data + i * numLanes; }
+        Register load (int i) const noexcept                    { return Register::fromRawArray (getSample (i)); }
+        void store (int i, Register value) const noexcept       { value.copyToRawArray (getSample (i)); }
+
+    private:
+        std::vector<float> storage;
+        float* data { nullptr };
+
+        JUCE_DECLARE_NON_COPYABLE (LaneBuffer)
+    };
+
+    // Sizes the lane buffers. process must never be given more samples than this
+    void prepare (int maximumBlockSize);
+
+    FilterData::CoefficientCache& getCoefficientCache() noexcept    { return coefficientCache; }
+
+    // Filters samples in place, with lane i belonging to filters[i].
+    // Every filter's beginBlock has to have been called for the block already
+    void process (FilterData* const* filters, const LaneBuffer& samples, int numSamples);
+
+private:
+    // Interleaves every filter's per-sample coefficients into gLanes, hLanes and dLanes, once for the block
+    void loadCoefficients (FilterData* const* filters, int numSamples) noexcept;
+
+    void processStateVariable (FilterData* const* filters, const LaneBuffer& samples, int numSamples);
+    void processStateVariableCascade (FilterData* const* filters, const LaneBuffer& samples, int numSamples);
+    void processLadder (FilterData* const* filters, const LaneBuffer& samples, int numSamples);
+
+    // Only needed if the filters' types differ, which they don't while the parameters reach every voice at once
+    void processEachLane (FilterData* const* filters, const LaneBuffer& samples, int numSamples);
+
+    FilterData::CoefficientCache coefficientCache;
+    LaneBuffer gLanes, hLanes, dLanes;
+    std::vector<float> laneSamples;
+};
+#endif
@@ -14,6 +14,8 @@
 //==============================================================================
 AdsrComponent::AdsrComponent(juce::String name, juce::AudioProcessorValueTreeState& apvts, juce::String attackId, juce::String decayId, juce::String sustainId, juce::String releaseId)
 {
+    // The frame fills the whole component, so nothing behind it has to be drawn when it repaints
+    setOpaque(true);
     
     componentName = name;
     
@@ -29,14 +31,17 @@ AdsrComponent::~AdsrComponent()
 
 void AdsrComponent::paint (juce::Graphics& g)
 {
-    auto bounds = getLocalBounds().reduced (5);
-    auto labelSpace = bounds.removeFromTop (25.0f);
-        
-    g.fillAll (juce::Colours::black);
-    g.setColour (juce::Colours::white);
-    g.setFont (20.0f);
-    g.drawText (componentName, labelSpace.withX (5), juce::Justification::left);
-    g.drawRoundedRectangle (bounds.toFloat(), 5.0f, 2.0f);
+    // The frame and title never change, so they're only drawn again when the size does
+    background.draw(g, getLocalBounds(), [this] (juce::Graphics& bg, juce::Rectangle<int> area){
+        auto bounds = area.reduced (5);
+        auto labelSpace = bounds.removeFromTop (25.0f);
+
+        bg.fillAll (juce::Colours::black);
+        bg.setColour (juce::Colours::white);
+        bg.setFont (20.0f);
+        bg.drawText (componentName, labelSpace.withX (5), juce::Justification::left);
+        bg.drawRoundedRectangle (bounds.toFloat(), 5.0f, 2.0f);
+    });
 }
 
 void AdsrComponent::resized()
@@ -0,0 +1,56 @@
+/*
+  ==============================================================================
+
+    CachedBackground.h
+    Created: 18 Oct 2026 5:12:09am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+//==============================================================================
+/*
+    The part of a component's paint() that never changes, drawn once into an image at the display's pixel scale
+    and only copied from then on. The image is drawn again when the component's size or the display's scale changes,
+    or after invalidate()
+*/
+class CachedBackground
+{
+public:
+    // renderBackground (juce::Graphics&, juce::Rectangle<int> area) is only called when the image needs drawing again
+    template <typename RenderFunction>
+    void draw (juce::Graphics& g, juce::Rectangle<int> area, RenderFunction&& renderBackground)
+    {
+        const auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+
+        if (needsRendering (area, scale))
+        {
+            image = juce::Image (juce::Image::ARGB, juce::jmax (1, juce::roundToInt ((float) area.getWidth() * scale)),
+                                 juce::jmax (1, juce::roundToInt ((float) area.getHeight() * scale)), true);
+            imageArea = area;
+            imageScale = scale;
+
+            juce::Graphics imageGraphics (image);
+            imageGraphics.addTransform (juce::AffineTransform::scale (scale));
+            renderBackground (imageGraphics, area.withPosition (0, 0));
+        }
+
+        g.drawImage (image, area.toFloat());
+    }
+
+    void invalidate() noexcept      { image = {}; }
+
+private:
+    bool needsRendering (juce::Rectangle<int> area, float scale) const noexcept
+    {
+        return ! image.isValid() || area != imageArea || scale != imageScale;
+    }
+
+    juce::Image image;
+    juce::Rectangle<int> imageArea;
+    float imageScale { 0.0f };
+};
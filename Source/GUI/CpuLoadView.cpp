@@ -0,0 +1,66 @@
+/*
+  ==============================================================================
+
+    CpuLoadView.cpp
+    Created: 18 Oct 2026 4:36:27am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "CpuLoadView.h"
+
+//==============================================================================
+CpuLoadView::CpuLoadView(const CpuLoadMeter& meterToShow)
+    : meter(meterToShow)
+    , lastNumNearMisses(meterToShow.getNumNearMisses())
+    , lastNumMisses(meterToShow.getNumMisses())
+{
+    timerCallback();
+    startTimerHz(refreshRateHz);
+}
+
+CpuLoadView::~CpuLoadView()
+{
+}
+
+void CpuLoadView::paint (juce::Graphics& g)
+{
+    g.setColour (colour);
+    g.setFont (13.0f);
+    g.drawText (text, getLocalBounds(), juce::Justification::centredLeft);
+}
+
+void CpuLoadView::timerCallback()
+{
+    // The counts only go up until the processor is prepared again, so anything that drops means they were cleared
+    const auto numNearMisses = meter.getNumNearMisses();
+    const auto numMisses = meter.getNumMisses();
+
+    if(numNearMisses > lastNumNearMisses)
+        nearMissCountdown = warningRefreshes;
+
+    if(numMisses > lastNumMisses)
+        missCountdown = warningRefreshes;
+
+    lastNumNearMisses = numNearMisses;
+    lastNumMisses = numMisses;
+    nearMissCountdown = juce::jmax(0, nearMissCountdown - 1);
+    missCountdown = juce::jmax(0, missCountdown - 1);
+
+    const auto newColour = missCountdown > 0 ? juce::Colours::red
+                         : nearMissCountdown > 0 ? juce::Colours::orange
+                         : juce::Colours::white;
+
+    juce::String newText;
+    newText << "CPU " << juce::roundToInt(meter.getLoad() * 100.0f) << "%  peak " << juce::roundToInt(meter.getPeakLoad() * 100.0f)
+            << "%  near misses " << (int) numNearMisses << "  misses " << (int) numMisses;
+
+    if(newText == text && newColour == colour)
+        return;
+
+    text = newText;
+    colour = newColour;
+    repaint();
+}
@@ -0,0 +1,47 @@
+/*
+  ==============================================================================
+
+    CpuLoadView.h
+    Created: 18 Oct 2026 4:36:27am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "CpuLoadMeter.h"
+
+//==============================================================================
+/*
+    The processor's load, peak load and near misses, refreshed a few times a second. The text turns orange
+    for a while after a near miss and red after a block missed its deadline
+*/
+class CpuLoadView  : public juce::Component,
+                     private juce::Timer
+{
+public:
+    explicit CpuLoadView(const CpuLoadMeter& meterToShow);
+    ~CpuLoadView() override;
+
+    void paint (juce::Graphics&) override;
+
+private:
+    void timerCallback() override;
+
+    // How many refreshes a warning colour stays up for after the miss that caused it
+    static constexpr int refreshRateHz = 4;
+    static constexpr int warningRefreshes = 5 * refreshRateHz;
+
+    const CpuLoadMeter& meter;
+    juce::String text;
+    juce::Colour colour { juce::Colours::white };
+
+    juce::uint32 lastNumNearMisses { 0 };
+    juce::uint32 lastNumMisses { 0 };
+    int nearMissCountdown { 0 };
+    int missCountdown { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (CpuLoadView)
+};
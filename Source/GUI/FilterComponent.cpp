@@ -14,9 +14,13 @@
 //==============================================================================
 FilterComponent::FilterComponent(juce::AudioProcessorValueTreeState& treeState, juce::String filterTypeSelectorId, juce::String filterFreqId, juce::String filterResId)
 {
+    // The frame fills the whole component, so nothing behind it has to be drawn when it repaints
+    setOpaque(true);
+    
+    // The choices are the parameter's own, so a new filter model shows up here without touching this
+    if(auto* choice = dynamic_cast<juce::AudioParameterChoice*>(treeState.getParameter(filterTypeSelectorId)))
+        filterTypeSelector.addItemList(choice->choices, 1);
     
-    juce::StringArray choices {"Low-Pass", "Band-Pass", "High-Pass"};
-    filterTypeSelector.addItemList(choices, 1);
     addAndMakeVisible(filterTypeSelector);
     
     // Make attachment
@@ -35,14 +39,17 @@ FilterComponent::~FilterComponent()
 
 void FilterComponent::paint (juce::Graphics& g)
 {
-    auto bounds = getLocalBounds().reduced (5);
-    auto labelSpace = bounds.removeFromTop (25.0f);
-    
-    g.fillAll(juce::Colours::black);
-    g.setColour (juce::Colours::white);
-    g.setFont (20.0f);
-    g.drawText ("Filter", labelSpace.withX (5), juce::Justification::left);
-    g.drawRoundedRectangle (bounds.toFloat(), 5.0f, 2.0f);
+    // The frame and title never change, so they're only drawn again when the size does
+    background.draw(g, getLocalBounds(), [] (juce::Graphics& bg, juce::Rectangle<int> area){
+        auto bounds = area.reduced (5);
+        auto labelSpace = bounds.removeFromTop (25.0f);
+
+        bg.fillAll(juce::Colours::black);
+        bg.setColour (juce::Colours::white);
+        bg.setFont (20.0f);
+        bg.drawText ("Filter", labelSpace.withX (5), juce::Justification::left);
+        bg.drawRoundedRectangle (bounds.toFloat(), 5.0f, 2.0f);
+    });
 }
 
 void FilterComponent::resized()
@@ -14,6 +14,9 @@
 //==============================================================================
 OscComponent::OscComponent(juce::AudioProcessorValueTreeState& treeState, juce::String waveSelectorId, juce::String fmFreqId, juce::String fmDepthId)
 {
+    // The frame fills the whole component, so nothing behind it has to be drawn when it repaints
+    setOpaque(true);
+    
     juce::StringArray choices {"Sine", "Saw", "Square"};
     oscWaveSelector.addItemList(choices, 1);
     addAndMakeVisible(oscWaveSelector);
@@ -35,14 +38,17 @@ OscComponent::~OscComponent()
 
 void OscComponent::paint (juce::Graphics& g)
 {
-    auto bounds = getLocalBounds().reduced (5);
-    auto labelSpace = bounds.removeFromTop (25.0f);
-    
-    g.fillAll(juce::Colours::black);
-    g.setColour (juce::Colours::white);
-    g.setFont (20.0f);
-    g.drawText ("Oscillator", labelSpace.withX (5), juce::Justification::left);
-    g.drawRoundedRectangle (bounds.toFloat(), 5.0f, 2.0f);
+    // The frame and title never change, so they're only drawn again when the size does
+    background.draw(g, getLocalBounds(), [] (juce::Graphics& bg, juce::Rectangle<int> area){
+        auto bounds = area.reduced (5);
+        auto labelSpace = bounds.removeFromTop (25.0f);
+
+        bg.fillAll(juce::Colours::black);
+        bg.setColour (juce::Colours::white);
+        bg.setFont (20.0f);
+        bg.drawText ("Oscillator", labelSpace.withX (5), juce::Justification::left);
+        bg.drawRoundedRectangle (bounds.toFloat(), 5.0f, 2.0f);
+    });
 }
 
 void OscComponent::resized()
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    OutputAnalyserView.cpp
+    Created: 18 Oct 2026 5:12:09am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "OutputAnalyserView.h"
+
+//==============================================================================
+OutputAnalyserView::OutputAnalyserView(AnalyserFifo& fifoToRead)
+    : fifo(fifoToRead)
+    , incoming(4096)
+    , history(fftSize, 0.0f)
+    , fftData(2 * fftSize, 0.0f)
+{
+    // Everything is drawn over a black background, so nothing behind the view has to be drawn when it repaints
+    setOpaque(true);
+
+    fifo.setReaderAttached(true);
+    startTimerHz(frameRateHz);
+}
+
+OutputAnalyserView::~OutputAnalyserView()
+{
+    fifo.setReaderAttached(false);
+}
+
+void OutputAnalyserView::paint (juce::Graphics& g)
+{
+    background.draw (g, getLocalBounds(), [this] (juce::Graphics& bg, juce::Rectangle<int> area) { drawBackground (bg, area); });
+
+    g.setColour (juce::Colours::white);
+    g.strokePath (scopePath, juce::PathStrokeType (1.5f));
+
+    g.setColour (juce::Colours::orange);
+    g.strokePath (spectrumPath, juce::PathStrokeType (1.5f));
+}
+
+void OutputAnalyserView::resized()
+{
+    // The same frame and title row as the sections above, with the scope on the left and the spectrum on the right
+    auto bounds = getLocalBounds().reduced (5);
+    bounds.removeFromTop (25);
+    bounds = bounds.reduced (10, 5);
+
+    scopeArea = bounds.removeFromLeft (bounds.getWidth() / 2 - 5);
+    bounds.removeFromLeft (10);
+    spectrumArea = bounds;
+
+    spectrumLevels.assign ((size_t) juce::jmax (0, spectrumArea.getWidth()), floorDecibels);
+    updateScope();
+    updateSpectrum();
+}
+
+void OutputAnalyserView::timerCallback()
+{
+    auto numNewSamples = 0;
+
+    for (int numRead; (numRead = fifo.pop(incoming.data(), (int) incoming.size())) > 0;)
+    {
+        // Only the latest fftSize samples are ever looked at
+        const auto numKept = juce::jmin(numRead, fftSize);
+        std::move(history.begin() + numKept, history.end(), history.begin());
+        std::copy_n(incoming.data() + numRead - numKept, numKept, history.end() - numKept);
+        numNewSamples += numRead;
+    }
+
+    // No blocks since the last frame (the host stopped, or the plugin is bypassed), so the picture stays as it was
+    if(numNewSamples == 0)
+        return;
+
+    updateScope();
+    updateSpectrum();
+    repaint();
+}
+
+void OutputAnalyserView::updateScope()
+{
+    scopePath.clear();
+
+    if(scopeArea.isEmpty())
+        return;
+
+    const auto numScopeSamples = juce::jlimit(16, fftSize / 2, (int) (fifo.getSampleRate() * scopeSeconds));
+
+    // Look back up to another scope length for a rising zero crossing, so a steady note stands still instead of scrolling
+    auto start = fftSize - numScopeSamples;
+
+    for (int i = start; i > fftSize - 2 * numScopeSamples; --i)
+    {
+        if(history[(size_t) i - 1] <= 0.0f && history[(size_t) i] > 0.0f)
+        {
+            start = i;
+            break;
+        }
+    }
+
+    const auto area = scopeArea.toFloat();
+    scopePath.preallocateSpace(3 * numScopeSamples);
+
+    for (int i = 0; i < numScopeSamples; ++i)
+    {
+        const auto x = area.getX() + area.getWidth() * (float) i / (float) (numScopeSamples - 1);
+        const auto y = area.getCentreY() - juce::jlimit(-1.0f, 1.0f, history[(size_t) (start + i)]) * area.getHeight() * 0.5f;
+
+        if(i == 0)
+            scopePath.startNewSubPath(x, y);
+        else
+            scopePath.lineTo(x, y);
+    }
+}
+
+void OutputAnalyserView::updateSpectrum()
+{
+    spectrumPath.clear();
+
+    if(spectrumLevels.empty())
+        return;
+
+    std::copy(history.begin(), history.end(), fftData.begin());
+    std::fill(fftData.begin() + fftSize, fftData.end(), 0.0f);
+    window.multiplyWithWindowingTable(fftData.data(), (size_t) fftSize);
+    fft.performFrequencyOnlyForwardTransform(fftData.data());
+
+    const auto binsPerHz = (float) (fftSize / fifo.getSampleRate());
+    const auto numColumns = (int) spectrumLevels.size();
+    const auto area = spectrumArea.toFloat();
+
+    for (int column = 0; column < numColumns; ++column)
+    {
+        // Each pixel column covers a slice of the log frequency axis and shows the loudest bin in it.
+        // A full scale sine through the Hann window peaks at a quarter of the FFT's size
+        const auto lowFrequency = minFrequency * std::pow(maxFrequency / minFrequency, (float) column / (float) numColumns);
+        const auto highFrequency = minFrequency * std::pow(maxFrequency / minFrequency, (float) (column + 1) / (float) numColumns);
+        const auto lowBin = juce::jlimit(1, fftSize / 2, (int) (lowFrequency * binsPerHz));
+        const auto highBin = juce::jlimit(lowBin, fftSize / 2, (int) (highFrequency * binsPerHz));
+
+        auto magnitude = 0.0f;
+
+        for (int bin = lowBin; bin <= highBin; ++bin)
+            magnitude = juce::jmax(magnitude, fftData[(size_t) bin]);
+
+        const auto level = juce::Decibels::gainToDecibels(magnitude * 4.0f / (float) fftSize, floorDecibels);
+        auto& shownLevel = spectrumLevels[(size_t) column];
+        shownLevel = juce::jmax(level, shownLevel - fallDecibels);
+
+        const auto x = area.getX() + (float) column;
+        const auto y = juce::jmap(shownLevel, floorDecibels, 0.0f, area.getBottom(), area.getY());
+
+        if(column == 0)
+            spectrumPath.startNewSubPath(x, y);
+        else
+            spectrumPath.lineTo(x, y);
+    }
+}
+
+void OutputAnalyserView::drawBackground (juce::Graphics& g, juce::Rectangle<int> area) const
+{
+    auto bounds = area.reduced (5);
+    auto labelSpace = bounds.removeFromTop (25);
+
+    g.fillAll (juce::Colours::black);
+    g.setColour (juce::Colours::white);
+    g.setFont (20.0f);
+    g.drawText ("Output", labelSpace.withX (5), juce::Justification::left);
+    g.drawRoundedRectangle (bounds.toFloat(), 5.0f, 2.0f);
+
+    // Scope: the zero line
+    g.setColour (juce::Colours::darkgrey);
+    g.drawHorizontalLine (scopeArea.getCentreY(), (float) scopeArea.getX(), (float) scopeArea.getRight());
+
+    // Spectrum: every decade from 100 Hz and every 30 dB
+    g.setFont (11.0f);
+
+    for (auto frequency : { 100.0f, 1000.0f, 10000.0f })
+    {
+        const auto x = spectrumArea.getX() + juce::roundToInt ((float) spectrumArea.getWidth() * std::log (frequency / minFrequency)
+                                                                / std::log (maxFrequency / minFrequency));
+        g.drawVerticalLine (x, (float) spectrumArea.getY(), (float) spectrumArea.getBottom());
+        g.drawText (frequency < 1000.0f ? juce::String ((int) frequency) : juce::String ((int) frequency / 1000) + "k",
+                    x + 2, spectrumArea.getBottom() - 12, 30, 12, juce::Justification::left);
+    }
+
+    for (auto decibels = -30.0f; decibels > floorDecibels; decibels -= 30.0f)
+    {
+        const auto y = juce::roundToInt (juce::jmap (decibels, floorDecibels, 0.0f, (float) spectrumArea.getBottom(), (float) spectrumArea.getY()));
+        g.drawHorizontalLine (y, (float) spectrumArea.getX(), (float) spectrumArea.getRight());
+        g.drawText (juce::String ((int) decibels) + " dB", spectrumArea.getX() + 2, y - 12, 40, 12, juce::Justification::left);
+    }
+}
@@ -0,0 +1,68 @@
+/*
+  ==============================================================================
+
+    OutputAnalyserView.h
+    Created: 18 Oct 2026 5:12:09am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "AnalyserFifo.h"
+#include "CachedBackground.h"
+
+//==============================================================================
+/*
+    A scope and a spectrum of the processor's output. The samples come from an AnalyserFifo, and all the analysis
+    and drawing happens on the message thread at most frameRateHz times a second. The view only repaints itself,
+    and only when new samples have arrived
+*/
+class OutputAnalyserView  : public juce::Component,
+                            private juce::Timer
+{
+public:
+    explicit OutputAnalyserView(AnalyserFifo& fifoToRead);
+    ~OutputAnalyserView() override;
+
+    void paint (juce::Graphics&) override;
+    void resized() override;
+
+private:
+    void timerCallback() override;
+    void updateScope();
+    void updateSpectrum();
+    void drawBackground (juce::Graphics& g, juce::Rectangle<int> area) const;
+
+    static constexpr int frameRateHz = 30;
+    static constexpr int fftOrder = 11;
+    static constexpr int fftSize = 1 << fftOrder;
+
+    // The scope shows about this long, starting at a rising zero crossing when there's one to line up on
+    static constexpr double scopeSeconds = 0.02;
+
+    // The spectrum runs from 20 Hz to 20 kHz and from floorDecibels to 0 dB, and its peaks fall back at fallDecibels per frame
+    static constexpr float minFrequency = 20.0f;
+    static constexpr float maxFrequency = 20000.0f;
+    static constexpr float floorDecibels = -90.0f;
+    static constexpr float fallDecibels = 1.5f;
+
+    AnalyserFifo& fifo;
+    juce::dsp::FFT fft { fftOrder };
+    juce::dsp::WindowingFunction<float> window { (size_t) fftSize, juce::dsp::WindowingFunction<float>::hann };
+
+    std::vector<float> incoming;        // what was read from the FIFO this frame
+    std::vector<float> history;         // the latest fftSize samples, oldest first
+    std::vector<float> fftData;         // the FFT works in place on twice its size
+    std::vector<float> spectrumLevels;  // in decibels, one for each pixel column of the spectrum
+
+    juce::Rectangle<int> scopeArea;
+    juce::Rectangle<int> spectrumArea;
+    juce::Path scopePath;
+    juce::Path spectrumPath;
+    CachedBackground background;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (OutputAnalyserView)
+};
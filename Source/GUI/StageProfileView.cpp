@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    StageProfileView.cpp
+    Created: 18 Oct 2026 3:31:50am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "StageProfileView.h"
+
+#if TAPSYNTH_PROFILING
+//==============================================================================
+StageProfileView::StageProfileView(StageProfiler& profilerToShow)
+    : profiler(profilerToShow)
+    , records(1024)
+    , text("Waiting for notes...")
+{
+    startTimerHz(2);
+}
+
+StageProfileView::~StageProfileView()
+{
+}
+
+void StageProfileView::paint (juce::Graphics& g)
+{
+    g.setColour (juce::Colours::white);
+    g.setFont (13.0f);
+    g.drawText (text, getLocalBounds().reduced (5, 0), juce::Justification::centredLeft);
+}
+
+void StageProfileView::timerCallback()
+{
+    // Every record counts once for each sample of its block, so longer blocks weigh in as much as they should
+    std::array<double, (size_t) StageTimes::numStages> cycles {};
+    double voiceSamples = 0.0;
+
+    for (int numRead; (numRead = profiler.pop(records.data(), (int) records.size())) > 0;)
+    {
+        for (int i = 0; i < numRead; ++i)
+        {
+            const auto& record = records[(size_t) i];
+            voiceSamples += record.numSamples;
+
+            for (size_t stage = 0; stage < cycles.size(); ++stage)
+                cycles[stage] += (double) record.cycles[stage];
+        }
+    }
+
+    // Nothing played, so the last numbers stay up
+    if (voiceSamples == 0.0)
+        return;
+
+    static constexpr const char* shortNames[StageTimes::numStages] { "osc", "fm", "amp", "mod", "filter", "gain", "mix" };
+    juce::String newText ("cycles/sample per voice: ");
+
+    for (size_t stage = 0; stage < cycles.size(); ++stage)
+        newText << shortNames[stage] << " " << juce::String(cycles[stage] / voiceSamples, 1) << "  ";
+
+    if (profiler.getNumDropped() > 0)
+        newText << "(" << (juce::int64) profiler.getNumDropped() << " dropped)";
+
+    text = newText.trimEnd();
+    repaint();
+}
+#endif
@@ -0,0 +1,40 @@
+/*
+  ==============================================================================
+
+    StageProfileView.h
+    Created: 18 Oct 2026 3:31:50am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "StageProfiler.h"
+
+#if TAPSYNTH_PROFILING
+//==============================================================================
+/*
+    A line along the bottom of the editor with the average cost of each stage of a voice, in cycles per sample,
+    over the last half second. It is the StageProfiler's reader while the editor is open
+*/
+class StageProfileView  : public juce::Component,
+                          private juce::Timer
+{
+public:
+    explicit StageProfileView(StageProfiler& profilerToShow);
+    ~StageProfileView() override;
+
+    void paint (juce::Graphics&) override;
+
+private:
+    void timerCallback() override;
+
+    StageProfiler& profiler;
+    std::vector<StageProfiler::Record> records;
+    juce::String text;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (StageProfileView)
+};
+#endif
@@ -0,0 +1,51 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.cpp
+    Created: 17 Oct 2026 9:12:37pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "HalfBandDecimator.h"
+
+// Elliptic half-band designs, worked out with the usual polyphase allpass method (as in Laurent de Soras' HIIR).
+// The final stage passes up to 0.44 of the output rate (19.4 kHz at 44.1 kHz) and stops about 90 dB from 0.56 up,
+// so whatever folds back lands above the passband. The 4x to 2x stage only has to keep content from folding
+// below 0.48 of the output rate, which it does with half the allpasses and about 80 dB of attenuation
+const float HalfBandDecimator::finalStageCoefficients[8]
+{
+    0.0472898531f, 0.1727806110f, 0.3385179585f, 0.5069776792f,
+    0.6552730688f, 0.7764899192f, 0.8745126132f, 0.9589457184f
+};
+
+const float HalfBandDecimator::firstStageCoefficients[4]
+{
+    0.0670134906f, 0.2468767582f, 0.4991291267f, 0.8095984264f
+};
+
+void HalfBandDecimator::setFactor (int newFactor) noexcept
+{
+    jassert (newFactor == 1 || newFactor == 2 || newFactor == maxFactor);
+
+    factor = newFactor;
+    reset();
+}
+
+void HalfBandDecimator::reset() noexcept
+{
+    finalStage.reset();
+    firstStage.reset();
+}
+
+void HalfBandDecimator::process (float* input, float* output, int numOutputSamples) noexcept
+{
+    if (factor == maxFactor)
+        firstStage.process (input, 2 * numOutputSamples);
+
+    if (factor > 1)
+        finalStage.process (input, numOutputSamples);
+
+    juce::FloatVectorOperations::add (output, input, numOutputSamples);
+}
@@ -0,0 +1,80 @@
+/*
+  ==============================================================================
+
+    HalfBandDecimator.h
+    Created: 17 Oct 2026 9:12:37pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Brings one channel of the engine's oversampled voice mix back down to the host rate, by a factor of 1, 2 or 4.
+// Each halving is a polyphase half-band IIR: two chains of first order allpasses, one for the even and one for the odd
+// input samples, run at the output rate and averaged. That costs a handful of multiplies per output sample and stage,
+// much less than an FIR of the same steepness, at the price of a phase response that isn't linear (which a synth doesn't mind).
+// The voices generate the oversampled signal directly, so there's no matching upsampler
+class HalfBandDecimator
+{
+public:
+    static constexpr int maxFactor = 4;
+
+    // Also clears the filters' state. factor has to be 1, 2 or 4
+    void setFactor (int newFactor) noexcept;
+    int getFactor() const noexcept    { return factor; }
+
+    void reset() noexcept;
+
+    // Reads numOutputSamples * getFactor() samples and adds numOutputSamples to output.
+    // The input is used as scratch space for the stages in between, so it's overwritten
+    void process (float* input, float* output, int numOutputSamples) noexcept;
+
+private:
+    // One halving of the rate. Coefficients alternate between the odd and the even path
+    template <int numCoefficients>
+    struct Stage
+    {
+        const float* coefficients;
+        std::array<float, (size_t) numCoefficients> inputs {};
+        std::array<float, (size_t) numCoefficients> outputs {};
+
+        explicit Stage (const float* c) noexcept : coefficients (c) {}
+
+        void reset() noexcept
+        {
+            inputs.fill (0.0f);
+            outputs.fill (0.0f);
+        }
+
+        // samples[i] becomes the filtered pair samples[2i], samples[2i + 1]. Output i never lands after input 2i, so this works in place
+        void process (float* samples, int numOutputSamples) noexcept
+        {
+            for (int i = 0; i < numOutputSamples; ++i)
+            {
+                float paths[2] { samples[2 * i + 1], samples[2 * i] };
+
+                for (int c = 0; c < numCoefficients; ++c)
+                {
+                    auto& x = paths[c & 1];
+                    const auto y = (x - outputs[(size_t) c]) * coefficients[c] + inputs[(size_t) c];
+                    inputs[(size_t) c] = x;
+                    outputs[(size_t) c] = y;
+                    x = y;
+                }
+
+                samples[i] = 0.5f * (paths[0] + paths[1]);
+            }
+        }
+    };
+
+    static const float finalStageCoefficients[8];
+    static const float firstStageCoefficients[4];
+
+    // 2x only uses the final stage. 4x runs the first stage from 4x to 2x, then the final one
+    Stage<8> finalStage { finalStageCoefficients };
+    Stage<4> firstStage { firstStageCoefficients };
+    int factor { 1 };
+};
@@ -0,0 +1,185 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.cpp
+    Created: 17 Oct 2026 1:26:08pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "ParameterSnapshot.h"
+
+const char* ParameterSnapshot::getParameterId (int index) noexcept
+{
+    static constexpr const char* ids[numParameters]
+    {
+        "OSC1WAVETYPE",
+        "OSC1FMFREQ",
+        "OSC1FMDEPTH",
+        "ATTACK",
+        "DECAY",
+        "SUSTAIN",
+        "RELEASE",
+        "MODATTACK",
+        "MODDECAY",
+        "MODSUSTAIN",
+        "MODRELEASE",
+        "FILTERTYPE",
+        "FILTERFREQ",
+        "FILTERRES",
+        "PANSPREAD",
+        "VOICESTEAL",
+        "OVERSAMPLING",
+        "OFFLINEOVERSAMPLING"
+    };
+
+    jassert (juce::isPositiveAndBelow (index, (int) numParameters));
+    return ids[index];
+}
+
+juce::uint32 ParameterSnapshot::getGroup (int index) noexcept
+{
+    switch (index)
+    {
+        case oscWaveType:
+            return oscillatorGroup;
+
+        case fmFrequency:
+        case fmDepth:
+            return fmGroup;
+
+        case attack:
+        case decay:
+        case sustain:
+        case release:
+            return ampEnvelopeGroup;
+
+        case modAttack:
+        case modDecay:
+        case modSustain:
+        case modRelease:
+            return modEnvelopeGroup;
+
+        case filterType:
+        case filterFrequency:
+        case filterResonance:
+            return filterGroup;
+
+        case panSpread:
+            return panGroup;
+
+        case voiceStealing:
+            return voiceGroup;
+
+        case oversampling:
+        case offlineOversampling:
+            return qualityGroup;
+
+        default:
+            jassertfalse;
+            return 0;
+    }
+}
+
+juce::uint16 ParameterSnapshot::getStateTag (int index) noexcept
+{
+    static constexpr juce::uint16 tags[numParameters]
+    {
+        1,      // OSC1WAVETYPE
+        2,      // OSC1FMFREQ
+        3,      // OSC1FMDEPTH
+        4,      // ATTACK
+        5,      // DECAY
+        6,      // SUSTAIN
+        7,      // RELEASE
+        8,      // MODATTACK
+        9,      // MODDECAY
+        10,     // MODSUSTAIN
+        11,     // MODRELEASE
+        12,     // FILTERTYPE
+        13,     // FILTERFREQ
+        14,     // FILTERRES
+        15,     // PANSPREAD
+        16,     // VOICESTEAL
+        17,     // OVERSAMPLING
+        18      // OFFLINEOVERSAMPLING
+    };
+
+    jassert (juce::isPositiveAndBelow (index, (int) numParameters));
+    return tags[index];
+}
+
+juce::uint32 ParameterSnapshot::getChangedGroups (const ParameterSnapshot& other) const noexcept
+{
+    juce::uint32 changedGroups = 0;
+
+    for (int i = 0; i < numParameters; ++i)
+        if (values[(size_t) i] != other.values[(size_t) i])
+            changedGroups |= getGroup (i);
+
+    return changedGroups;
+}
+
+//==============================================================================
+ParameterSnapshotReader::ParameterSnapshotReader (juce::AudioProcessorValueTreeState& treeState)
+{
+    for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+    {
+        parameters[(size_t) i] = treeState.getRawParameterValue (ParameterSnapshot::getParameterId (i));
+
+        // Every ID in the table has to exist in the processor's parameter layout
+        jassert (parameters[(size_t) i] != nullptr);
+    }
+}
+
+void ParameterSnapshotReader::read (ParameterSnapshot& snapshot) const noexcept
+{
+    for (size_t i = 0; i < parameters.size(); ++i)
+        snapshot.values[i] = parameters[i]->load (std::memory_order_relaxed);
+}
+
+//==============================================================================
+ParameterSnapshotWriter::ParameterSnapshotWriter (juce::AudioProcessorValueTreeState& treeState)
+{
+    for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+    {
+        parameters[(size_t) i] = treeState.getParameter (ParameterSnapshot::getParameterId (i));
+        jassert (parameters[(size_t) i] != nullptr);
+    }
+}
+
+void ParameterSnapshotWriter::write (const ParameterSnapshot& snapshot, const std::bitset<ParameterSnapshot::numParameters>& isPresent) const
+{
+    auto sanitised = snapshot;
+    sanitise (sanitised);
+
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        auto* parameter = parameters[i];
+
+        const auto newValue = isPresent[i] ? parameter->convertTo0to1 (sanitised.values[i])
+                                           : parameter->getDefaultValue();
+
+        // Leaving unchanged parameters alone keeps the host from seeing a flood of automation on every restore
+        if (newValue != parameter->getValue())
+            parameter->setValueNotifyingHost (newValue);
+    }
+}
+
+void ParameterSnapshotWriter::readDefaults (ParameterSnapshot& snapshot) const
+{
+    for (size_t i = 0; i < parameters.size(); ++i)
+        snapshot.values[i] = parameters[i]->convertFrom0to1 (parameters[i]->getDefaultValue());
+}
+
+void ParameterSnapshotWriter::sanitise (ParameterSnapshot& snapshot) const noexcept
+{
+    for (size_t i = 0; i < parameters.size(); ++i)
+    {
+        auto& value = snapshot.values[i];
+
+        value = std::isfinite (value) ? parameters[i]->getNormalisableRange().getRange().clipValue (value)
+                                      : parameters[i]->convertFrom0to1 (parameters[i]->getDefaultValue());
+    }
+}
@@ -0,0 +1,104 @@
+/*
+  ==============================================================================
+
+    ParameterSnapshot.h
+    Created: 17 Oct 2026 1:26:08pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <bitset>
+
+// A copy of every synth parameter, taken once per block so the audio thread reads each atomic exactly once
+struct ParameterSnapshot
+{
+    enum Index
+    {
+        oscWaveType = 0,
+        fmFrequency,
+        fmDepth,
+        attack,
+        decay,
+        sustain,
+        release,
+        modAttack,
+        modDecay,
+        modSustain,
+        modRelease,
+        filterType,
+        filterFrequency,
+        filterResonance,
+        panSpread,
+        voiceStealing,
+        oversampling,
+        offlineOversampling,
+        numParameters
+    };
+
+    // Parameters are pushed to the voices in groups, matching the voice methods that consume them
+    enum Group : juce::uint32
+    {
+        oscillatorGroup   = 1 << 0,
+        fmGroup           = 1 << 1,
+        ampEnvelopeGroup  = 1 << 2,
+        filterGroup       = 1 << 3,
+        modEnvelopeGroup  = 1 << 4,
+        panGroup          = 1 << 5,
+        voiceGroup        = 1 << 6,
+        qualityGroup      = 1 << 7,
+        allGroups         = (1 << 8) - 1
+    };
+
+    // The AudioProcessorValueTreeState ID of each parameter, in Index order
+    static const char* getParameterId (int index) noexcept;
+    static juce::uint32 getGroup (int index) noexcept;
+
+    // The tag that identifies each parameter in saved state (see PatchState). Tags are permanent:
+    // a new parameter gets the next unused number, and a removed parameter's tag is never given to anything else
+    static juce::uint16 getStateTag (int index) noexcept;
+
+    float operator[] (int index) const noexcept { return values[(size_t) index]; }
+    float& operator[] (int index) noexcept { return values[(size_t) index]; }
+
+    // Returns the Group bits of every parameter whose value differs from the other snapshot
+    juce::uint32 getChangedGroups (const ParameterSnapshot& other) const noexcept;
+
+    std::array<float, numParameters> values {};
+};
+
+// Looks up the raw parameter atomics once, then fills ParameterSnapshots from them without any string lookups
+class ParameterSnapshotReader
+{
+public:
+    explicit ParameterSnapshotReader (juce::AudioProcessorValueTreeState& treeState);
+
+    void read (ParameterSnapshot& snapshot) const noexcept;
+
+private:
+    std::array<std::atomic<float>*, ParameterSnapshot::numParameters> parameters {};
+};
+
+// The other direction: sets the processor's parameters from a snapshot, telling the host about every value that changes.
+// Call it from the message thread, the voices then pick the new values up on the next block
+class ParameterSnapshotWriter
+{
+public:
+    explicit ParameterSnapshotWriter (juce::AudioProcessorValueTreeState& treeState);
+
+    // Parameters whose flag in isPresent is false go back to their default value
+    void write (const ParameterSnapshot& snapshot, const std::bitset<ParameterSnapshot::numParameters>& isPresent) const;
+
+    // Fills the snapshot with every parameter's default value
+    void readDefaults (ParameterSnapshot& snapshot) const;
+
+    // Gives every value that isn't finite its parameter's default and clamps the rest to the parameter's range,
+    // so state or banks from elsewhere can't hand the voices anything the controls couldn't
+    void sanitise (ParameterSnapshot& snapshot) const noexcept;
+
+private:
+    std::array<juce::RangedAudioParameter*, ParameterSnapshot::numParameters> parameters {};
+};
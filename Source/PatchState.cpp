@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    PatchState.cpp
+    Created: 17 Oct 2026 3:12:27pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "PatchState.h"
+
+namespace
+{
+    void writeUint16 (char* dest, juce::uint16 value) noexcept
+    {
+        dest[0] = (char) (value & 0xff);
+        dest[1] = (char) (value >> 8);
+    }
+
+    juce::uint16 readUint16 (const char* source) noexcept
+    {
+        return juce::ByteOrder::littleEndianShort (source);
+    }
+
+    void writeFloat (char* dest, float value) noexcept
+    {
+        juce::uint32 bits;
+        std::memcpy (&bits, &value, sizeof (bits));
+
+        for (int i = 0; i < 4; ++i)
+            dest[i] = (char) ((bits >> (8 * i)) & 0xff);
+    }
+
+    float readFloat (const char* source) noexcept
+    {
+        const auto bits = (juce::uint32) juce::ByteOrder::littleEndianInt (source);
+        float value;
+        std::memcpy (&value, &bits, sizeof (value));
+        return value;
+    }
+}
+
+void PatchState::write (const ParameterSnapshot& snapshot, juce::MemoryBlock& destData)
+{
+    // The whole state is sized up front, so saving costs one allocation at most
+    destData.setSize (headerSize + (size_t) ParameterSnapshot::numParameters * floatFieldSize);
+    auto* dest = static_cast<char*> (destData.getData());
+
+    std::memcpy (dest, magic, sizeof (magic));
+    writeUint16 (dest + 4, currentVersion);
+    writeUint16 (dest + 6, (juce::uint16) ParameterSnapshot::numParameters);
+    dest += headerSize;
+
+    for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+    {
+        writeUint16 (dest, ParameterSnapshot::getStateTag (i));
+        writeUint16 (dest + 2, (juce::uint16) sizeof (float));
+        writeFloat (dest + fieldHeaderSize, snapshot[i]);
+        dest += floatFieldSize;
+    }
+}
+
+bool PatchState::read (const void* data, size_t sizeInBytes, ParameterSnapshot& snapshot,
+                       std::bitset<ParameterSnapshot::numParameters>& isPresent)
+{
+    const auto* source = static_cast<const char*> (data);
+
+    if (source == nullptr || sizeInBytes < headerSize || std::memcmp (source, magic, sizeof (magic)) != 0)
+        return false;
+
+    // New fields don't change the version, the tags let us skip them. A higher version has fields we'd misread
+    const auto version = readUint16 (source + 4);
+
+    if (version == 0 || version > currentVersion)
+        return false;
+
+    const auto numFields = readUint16 (source + 6);
+
+    // Parse into a copy first, so a state that turns out to be truncated halfway leaves everything as it was
+    auto parsed = snapshot;
+    std::bitset<ParameterSnapshot::numParameters> found;
+    auto position = headerSize;
+
+    for (int field = 0; field < numFields; ++field)
+    {
+        if (sizeInBytes - position < fieldHeaderSize)
+            return false;
+
+        const auto tag = readUint16 (source + position);
+        const auto size = (size_t) readUint16 (source + position + 2);
+        position += fieldHeaderSize;
+
+        if (sizeInBytes - position < size)
+            return false;
+
+        if (size >= sizeof (float))
+        {
+            for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+            {
+                if (ParameterSnapshot::getStateTag (i) == tag)
+                {
+                    const auto value = readFloat (source + position);
+
+                    if (std::isfinite (value))
+                    {
+                        parsed[i] = value;
+                        found.set ((size_t) i);
+                    }
+
+                    break;
+                }
+            }
+        }
+
+        position += size;
+    }
+
+    snapshot = parsed;
+    isPresent = found;
+    return true;
+}
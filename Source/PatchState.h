@@ -0,0 +1,45 @@
+/*
+  ==============================================================================
+
+    PatchState.h
+    Created: 17 Oct 2026 3:12:27pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterSnapshot.h"
+
+// The binary format that getStateInformation writes and setStateInformation reads. Everything is little-endian:
+//
+//   magic     4 bytes, "TSst"
+//   version   uint16, currentVersion when written
+//   numFields uint16
+//   fields    numFields times { uint16 tag, uint16 size, size bytes of payload }
+//
+// Parameter fields use ParameterSnapshot::getStateTag and a 4 byte float payload holding the plain (not normalised) value.
+// Readers skip tags they don't know and payloads longer than they expect. A version above currentVersion means a field
+// has changed meaning, so that state is rejected rather than misread; only bump it for a change like that, not for new fields
+class PatchState
+{
+public:
+    static constexpr juce::uint16 currentVersion = 1;
+
+    static void write (const ParameterSnapshot& snapshot, juce::MemoryBlock& destData);
+
+    // Fills in every parameter found in the data and sets its flag in isPresent. The others, and any whose value isn't finite,
+    // are left alone. Returns false, without touching anything, if the data isn't a TapSynth state, is from an unknown version
+    // or is cut short. The values aren't checked against the parameters' ranges, see ParameterSnapshotWriter::sanitise
+    static bool read (const void* data, size_t sizeInBytes, ParameterSnapshot& snapshot,
+                      std::bitset<ParameterSnapshot::numParameters>& isPresent);
+
+    static constexpr size_t headerSize = 8;
+    static constexpr size_t fieldHeaderSize = 4;
+    static constexpr size_t floatFieldSize = fieldHeaderSize + sizeof (float);
+
+private:
+    static constexpr char magic[4] { 'T', 'S', 's', 't' };
+};
@@ -20,13 +20,26 @@ TapSynthAudioProcessorEditor::TapSynthAudioProcessorEditor (TapSynthAudioProcess
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize (620, 500);
+   #if TAPSYNTH_PROFILING
+    setSize (620, 440 + analyserHeight + profileViewHeight);
+   #else
+    setSize (620, 440 + analyserHeight);
+   #endif
     
     // Make components visible
     addAndMakeVisible(osc);
     addAndMakeVisible(adsr);
     addAndMakeVisible(filter);
     addAndMakeVisible(modAdsr);
+    addAndMakeVisible(analyser);
+    
+    setSelectorWithLabel(oversamplingSelector, oversamplingLabel, "OVERSAMPLING", oversamplingAttachment);
+    setSelectorWithLabel(offlineOversamplingSelector, offlineOversamplingLabel, "OFFLINEOVERSAMPLING", offlineOversamplingAttachment);
+    addAndMakeVisible(cpuLoadView);
+    
+   #if TAPSYNTH_PROFILING
+    addAndMakeVisible(stageProfileView);
+   #endif
 }
 
 TapSynthAudioProcessorEditor::~TapSynthAudioProcessorEditor()
@@ -51,5 +64,38 @@ void TapSynthAudioProcessorEditor::resized()
     adsr.setBounds (osc.getRight(), paddingY, width, height);
     filter.setBounds(paddingX, osc.getBottom(), width, height);
     modAdsr.setBounds(filter.getRight(), adsr.getBottom(), width, height);
+    analyser.setBounds(paddingX, filter.getBottom(), width * 2, analyserHeight);
+    
+    // The quality selectors sit in the strip above the sections, lined up with the right hand column
+    const auto selectorWidth = 70;
+    const auto selectorHeight = 25;
+    const auto selectorY = (paddingY - selectorHeight) / 2;
+    
+    offlineOversamplingSelector.setBounds(adsr.getRight() - selectorWidth - 5, selectorY, selectorWidth, selectorHeight);
+    offlineOversamplingLabel.setBounds(offlineOversamplingSelector.getX() - 55, selectorY, 55, selectorHeight);
+    oversamplingSelector.setBounds(offlineOversamplingLabel.getX() - selectorWidth - 5, selectorY, selectorWidth, selectorHeight);
+    oversamplingLabel.setBounds(oversamplingSelector.getX() - 95, selectorY, 95, selectorHeight);
+    
+    // The load meter takes what's left of the strip, lined up with the left hand column
+    cpuLoadView.setBounds(paddingX + 5, selectorY, oversamplingLabel.getX() - paddingX - 5, selectorHeight);
+    
+   #if TAPSYNTH_PROFILING
+    stageProfileView.setBounds(0, getHeight() - profileViewHeight, getWidth(), profileViewHeight);
+   #endif
+}
+
+void TapSynthAudioProcessorEditor::setSelectorWithLabel(juce::ComboBox& selector, juce::Label& label, juce::String paramID, std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>& attachment)
+{
+    // The choices are the parameter's own, so the box always matches what the host shows
+    if(auto* choice = dynamic_cast<juce::AudioParameterChoice*>(audioProcessor.treeState.getParameter(paramID)))
+        selector.addItemList(choice->choices, 1);
+    
+    addAndMakeVisible(selector);
+    attachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(audioProcessor.treeState, paramID, selector);
+    
+    label.setColour(juce::Label::ColourIds::textColourId, juce::Colours::white);
+    label.setJustificationType(juce::Justification::centredRight);
+    label.setFont(15.0f);
+    addAndMakeVisible(label);
 }
 
@@ -13,6 +13,9 @@
 #include "AdsrComponent.h"
 #include "OscComponent.h"
 #include "FilterComponent.h"
+#include "StageProfileView.h"
+#include "CpuLoadView.h"
+#include "OutputAnalyserView.h"
 
 //==============================================================================
 /**
@@ -35,5 +38,28 @@ private:
     FilterComponent filter;
     AdsrComponent modAdsr;
     
+    // Scope and spectrum of the output, under the sections
+    static constexpr int analyserHeight = 150;
+    OutputAnalyserView analyser { audioProcessor.getAnalyserFifo() };
+    
+    // Oversampling for live playing and for offline renders, along the top of the window
+    juce::ComboBox oversamplingSelector {"Oversampling"};
+    juce::ComboBox offlineOversamplingSelector {"Offline Oversampling"};
+    juce::Label oversamplingLabel {"Oversampling", "Oversampling"};
+    juce::Label offlineOversamplingLabel {"Offline", "Offline"};
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> oversamplingAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> offlineOversamplingAttachment;
+    
+    void setSelectorWithLabel(juce::ComboBox& selector, juce::Label& label, juce::String paramID, std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>& attachment);
+    
+    // How close this instance comes to its deadlines, in the top left corner
+    CpuLoadView cpuLoadView { audioProcessor.getCpuLoadMeter() };
+    
+   #if TAPSYNTH_PROFILING
+    // Builds with profiling show where the voices' time goes along the bottom of the window
+    static constexpr int profileViewHeight = 20;
+    StageProfileView stageProfileView { audioProcessor.getSynth().getStageProfiler() };
+   #endif
+    
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TapSynthAudioProcessorEditor)
 };
@@ -7,10 +7,12 @@
 */
 
 #include "PluginProcessor.h"
-#include "PluginEditor.h"
+#if ! TAPSYNTH_HEADLESS
+ #include "PluginEditor.h"
+#endif
 
 //==============================================================================
-TapSynthAudioProcessor::TapSynthAudioProcessor()
+TapSynthAudioProcessor::TapSynthAudioProcessor (int numVoices, const juce::File& presetBankFile)
 #ifndef JucePlugin_PreferredChannelConfigurations
      : AudioProcessor (BusesProperties()
                      #if ! JucePlugin_IsMidiEffect
@@ -21,17 +23,24 @@ TapSynthAudioProcessor::TapSynthAudioProcessor()
                      #endif
                        ),
                     // Create constructor for the apvts
-                    treeState(*this, nullptr, "Parameters", createParams())
+                    treeState(*this, nullptr, "Parameters", createParams()),
+                    // The engine allocates all of its voices up front in one contiguous pool
+                    synth(numVoices),
+                    parameterReader(treeState),
+                    parameterWriter(treeState)
 #endif
 {
-    // Add the SynthSound and SynthVoice objects to the synth object
-    // The methods here manages the pointer input so we don't need to delete it in the destructor
+    // Add the SynthSound object to the synth object
+    // The method here manages the pointer input so we don't need to delete it in the destructor
     synth.addSound(new SynthSound());
-    synth.addVoice(new SynthVoice());
+    
+    if(presetBankFile.existsAsFile())
+        loadPresetBank(presetBankFile);
 }
 
 TapSynthAudioProcessor::~TapSynthAudioProcessor()
 {
+    stopTimer();
 }
 
 //==============================================================================
@@ -74,43 +83,135 @@ double TapSynthAudioProcessor::getTailLengthSeconds() const
 
 int TapSynthAudioProcessor::getNumPrograms()
 {
-    return 1;   // NB: some hosts don't cope very well if you tell them there are 0 programs,
-                // so this should be at least 1, even if you're not really implementing programs.
+    auto* bank = presetBank.getBank();
+    
+    // NB: some hosts don't cope very well if you tell them there are 0 programs,
+    // so this should be at least 1, even if there's no preset bank.
+    return juce::jmax(1, bank != nullptr ? bank->getNumPrograms() : 0);
 }
 
 int TapSynthAudioProcessor::getCurrentProgram()
 {
-    return 0;
+    return currentProgram.load();
 }
 
 void TapSynthAudioProcessor::setCurrentProgram (int index)
 {
+    if(auto* bank = presetBank.getBank())
+        if(juce::isPositiveAndBelow(index, bank->getNumPrograms()))
+            applyProgram(PresetBank::makeProgramId(*bank, index));
 }
 
 const juce::String TapSynthAudioProcessor::getProgramName (int index)
 {
-    return {};
+    const auto renamed = renamedPrograms.find(index);
+    
+    if(renamed != renamedPrograms.end())
+        return renamed->second;
+    
+    auto* bank = presetBank.getBank();
+    return bank != nullptr ? bank->getProgramName(index) : juce::String();
 }
 
 void TapSynthAudioProcessor::changeProgramName (int index, const juce::String& newName)
 {
+    // The bank file is mapped read-only and shared with every other instance, so new names only last for this session
+    renamedPrograms[index] = newName;
 }
 
-//==============================================================================
-void TapSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+bool TapSynthAudioProcessor::loadPresetBank (const juce::File& file)
+{
+    if(! presetBank.load(file, parameterWriter))
+        return false;
+    
+    renamedPrograms.clear();
+    currentProgram.store(0);
+    
+    // Picks up program changes the audio thread received from MIDI, and frees replaced banks once the audio thread has let go of them
+    startTimerHz(30);
+    
+    updateHostDisplay(juce::AudioProcessor::ChangeDetails().withProgramChanged(true));
+    return true;
+}
+
+juce::File TapSynthAudioProcessor::getDefaultPresetBankFile()
+{
+    return juce::File::getSpecialLocation(juce::File::userApplicationDataDirectory).getChildFile("TapSynth").getChildFile("Presets.tsbank");
+}
+
+void TapSynthAudioProcessor::resetPlaybackState()
+{
+    synth.reset();
+    
+    // Only the timer applies program changes, and without a message loop it never runs, so one would carry on into the next piece
+    pendingProgram.store(0);
+    currentProgram.store(0);
+    bankSelectMsb = 0;
+    bankSelectLsb = 0;
+    
+    // The voices start over too, so they get every parameter again
+    parameterGroupsToPush = ParameterSnapshot::allGroups;
+}
+
+void TapSynthAudioProcessor::handleProgramChanges (const juce::MidiBuffer& midiMessages, const PresetBank::Bank* bank) noexcept
 {
-    synth.setCurrentPlaybackSampleRate(sampleRate);
-    
-    // Iterate through the synth's voices
-    for(int i = 0; i < synth.getNumVoices(); i++){
-        // Since synth.getVoice(i) returns a SynthesiserVoice object, we need to cast it to our own SynthVoice class
-        // if cast is successful
-        if(auto voice = dynamic_cast<SynthVoice*>(synth.getVoice(i))){
-            voice -> prepareToPlay(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+    // Runs on the audio thread, so the program has to be in the bank already: nothing gets read from disk here
+    for(const auto metadata : midiMessages){
+        const auto message = metadata.getMessage();
+        
+        if(message.isController()){
+            if(message.getControllerNumber() == 0)  bankSelectMsb = message.getControllerValue();
+            if(message.getControllerNumber() == 32) bankSelectLsb = message.getControllerValue();
+        }
+        else if(message.isProgramChange() && bank != nullptr){
+            const auto index = ((bankSelectMsb << 7) | bankSelectLsb) * 128 + message.getProgramChangeNumber();
+            
+            if(juce::isPositiveAndBelow(index, bank->getNumPrograms())){
+                pendingProgram.store(PresetBank::makeProgramId(*bank, index));
+                currentProgram.store(index);
+            }
         }
     }
 }
 
+void TapSynthAudioProcessor::applyProgram (juce::uint64 programId)
+{
+    auto* bank = presetBank.getBank();
+    auto* program = bank != nullptr ? bank->findProgram(programId) : nullptr;
+    
+    if(program != nullptr){
+        // Hand the audio thread the whole program first, so it never plays a mix of old and new parameters while they're written
+        pendingProgram.store(programId);
+        currentProgram.store(PresetBank::getProgramIndex(programId));
+        parameterWriter.write(*program, std::bitset<ParameterSnapshot::numParameters>().set());
+        updateHostDisplay(juce::AudioProcessor::ChangeDetails().withProgramChanged(true));
+    }
+    
+    // treeState has caught up now, unless the audio thread got another program change in the meantime
+    pendingProgram.compare_exchange_strong(programId, 0);
+}
+
+void TapSynthAudioProcessor::timerCallback()
+{
+    if(const auto programId = pendingProgram.load())
+        applyProgram(programId);
+    
+    presetBank.releaseRetiredBanks();
+}
+
+//==============================================================================
+void TapSynthAudioProcessor::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    // This sets the synth's sample rate and prepares every voice in its pool
+    // The voices are mono whatever the output layout is, they're only spread across the channels when they're mixed in
+    synth.prepareToPlay(sampleRate, samplesPerBlock);
+    cpuLoadMeter.prepare(sampleRate);
+    analyserFifo.prepare(sampleRate);
+    
+    // Freshly prepared voices need every parameter, not just the ones that change from now on
+    parameterGroupsToPush = ParameterSnapshot::allGroups;
+}
+
 void TapSynthAudioProcessor::releaseResources()
 {
     // When playback stops, you can use this as an opportunity to free up any
@@ -146,49 +247,37 @@ bool TapSynthAudioProcessor::isBusesLayoutSupported (const BusesLayout& layouts)
 void TapSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    
+    // Everything the block does counts against its deadline, including the early return when nothing plays
+    const CpuLoadMeter::ScopedMeasurement loadMeasurement(cpuLoadMeter, buffer.getNumSamples(), ! isNonRealtime());
+    
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
 
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
     
+    // The bank stays valid until the end of this block, even if the message thread loads another one meanwhile
+    const auto* bank = presetBank.getBankForAudioThread();
+    handleProgramChanges(midiMessages, bank);
     
-    for(int i = 0; i < synth.getNumVoices(); ++i){
-        // If the cast is successful
-        if(auto voice = dynamic_cast<SynthVoice*>(synth.getVoice(i))){
-            // We access each voice and do an update from the parameters from a Value Tree object
-            
-            // ADSR
-            auto& attack = *treeState.getRawParameterValue("ATTACK");
-            auto& decay = *treeState.getRawParameterValue("DECAY");
-            auto& sustain = *treeState.getRawParameterValue("SUSTAIN");
-            auto& release = *treeState.getRawParameterValue("RELEASE");
-            
-            // Filter
-            auto& filterType = *treeState.getRawParameterValue("FILTERTYPE");
-            auto& frequency = *treeState.getRawParameterValue("FILTERFREQ");
-            auto& resonance = *treeState.getRawParameterValue("FILTERRES");
-            
-            // Filter Mod ADSR
-            auto& modAttack = *treeState.getRawParameterValue("MODATTACK");
-            auto& modDecay = *treeState.getRawParameterValue("MODDECAY");
-            auto& modSustain = *treeState.getRawParameterValue("MODSUSTAIN");
-            auto& modRelease = *treeState.getRawParameterValue("MODRELEASE");
-            
-            auto& oscWaveChoice = *treeState.getRawParameterValue("OSC1WAVETYPE");
-            
-            auto& FMFreq = *treeState.getRawParameterValue("OSC1FMFREQ");
-            auto& FMDepth = *treeState.getRawParameterValue("OSC1FMDEPTH");
-            
-            voice -> getOscillator().setWaveType(oscWaveChoice);
-            voice -> getOscillator().setFmParams(FMFreq, FMDepth);
-            voice -> updateAdsr(attack.load(), decay.load(), sustain.load(), release.load());
-            voice -> updateFilter(filterType.load(), frequency.load(), resonance.load());
-            voice -> updateModAdsr(modAttack.load(), modDecay.load(), modSustain.load(), modRelease.load());
-        }
+    // Take this block's parameters from the Value Tree object (or the program being switched to)
+    readParameters(bank);
+    
+    // With every voice asleep and no MIDI to wake one, there's nothing to render. The voices aren't touched at all,
+    // the parameters that changed meanwhile are pushed once something plays again
+    if(! synth.isSounding() && midiMessages.isEmpty())
+    {
+        analyserFifo.push(buffer, buffer.getNumSamples());
+        return;
     }
     
+    // Update the voices from the parameters that changed
+    pushChangedParametersToVoices();
     
+    // Bouncing can afford more oversampling than playing live. Hosts say which one they're doing, and can change it between blocks
+    const auto oversampling = isNonRealtime() ? ParameterSnapshot::offlineOversampling : ParameterSnapshot::oversampling;
+    synth.setOversamplingFactor(1 << (int) lastParameters[oversampling]);
     
     // Getting metadata on the midi message
     // In this case, we want to get the specific timestamp in the buffer of when our midi message is received
@@ -196,41 +285,119 @@ void TapSynthAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juc
     //    if (metadata.numBytes == 3)
     //        juce::Logger::writeToLog ("Timestamp: " + juce::String (metadata.getMessage().getTimeStamp()));
 
-    // renderNextBlock calls processNextBlock, which calls renderVoices, which calls renderNextBlock (member function of SynthVoice class)
+    // Our engine's renderNextBlock handles the MIDI chunk by chunk and calls renderVoices, which calls renderNextBlock (member function of SynthVoice class)
     // Point is all this is controlled and managed by the synth
     synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    
+    // The editor's scope and spectrum get a copy of the output, if the editor is open
+    analyserFifo.push(buffer, buffer.getNumSamples());
+}
+
+void TapSynthAudioProcessor::readParameters (const PresetBank::Bank* bank)
+{
+    // Take one snapshot of all parameters for this block, or use the program that's being switched to
+    ParameterSnapshot parameters;
+    const auto* program = bank != nullptr ? bank->findProgram(pendingProgram.load()) : nullptr;
+    
+    if(program != nullptr)
+        parameters = *program;
+    else
+        parameterReader.read(parameters);
+    
+    // The changes add up until they're pushed, so blocks that skip the voices don't lose any
+    parameterGroupsToPush |= parameters.getChangedGroups(lastParameters);
+    lastParameters = parameters;
+}
+
+void TapSynthAudioProcessor::pushChangedParametersToVoices()
+{
+    const auto changedGroups = parameterGroupsToPush;
+    const auto& parameters = lastParameters;
+    parameterGroupsToPush = 0;
+    
+    // Nothing is automating, so the voices already have every value
+    if(changedGroups == 0) return;
+    
+    if(changedGroups & ParameterSnapshot::voiceGroup)
+        synth.setStealPolicy((VoiceAllocator::StealPolicy) (int) parameters[ParameterSnapshot::voiceStealing]);
+    
+    // The voice pool hands us our own SynthVoice objects directly, so there is no need to cast them
+    for(auto& voice : synth.getVoicePool()){
+        if(changedGroups & ParameterSnapshot::oscillatorGroup)
+            voice.getOscillator().setWaveType((int) parameters[ParameterSnapshot::oscWaveType]);
+        
+        if(changedGroups & ParameterSnapshot::fmGroup)
+            voice.getOscillator().setFmParams(parameters[ParameterSnapshot::fmFrequency], parameters[ParameterSnapshot::fmDepth]);
+        
+        if(changedGroups & ParameterSnapshot::ampEnvelopeGroup)
+            voice.updateAdsr(parameters[ParameterSnapshot::attack], parameters[ParameterSnapshot::decay], parameters[ParameterSnapshot::sustain], parameters[ParameterSnapshot::release]);
+        
+        if(changedGroups & ParameterSnapshot::filterGroup)
+            voice.updateFilter((int) parameters[ParameterSnapshot::filterType], parameters[ParameterSnapshot::filterFrequency], parameters[ParameterSnapshot::filterResonance]);
+        
+        if(changedGroups & ParameterSnapshot::modEnvelopeGroup)
+            voice.updateModAdsr(parameters[ParameterSnapshot::modAttack], parameters[ParameterSnapshot::modDecay], parameters[ParameterSnapshot::modSustain], parameters[ParameterSnapshot::modRelease]);
+        
+        if(changedGroups & ParameterSnapshot::panGroup)
+            voice.setPanSpread(parameters[ParameterSnapshot::panSpread]);
+    }
 }
 
 //==============================================================================
 bool TapSynthAudioProcessor::hasEditor() const
 {
+   #if TAPSYNTH_HEADLESS
+    // The headless core library (benchmarks and command line tools) is built without any GUI sources
+    return false;
+   #else
     return true; // (change this to false if you choose to not supply an editor)
+   #endif
 }
 
 juce::AudioProcessorEditor* TapSynthAudioProcessor::createEditor()
 {
+   #if TAPSYNTH_HEADLESS
+    return nullptr;
+   #else
     return new TapSynthAudioProcessorEditor (*this);
+   #endif
 }
 
 //==============================================================================
 void TapSynthAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
+    // The parameters are stored in our compact binary format (see PatchState) rather than as XML,
+    // which keeps the state small and cheap to take, whether for a saved project or one of the host's undo snapshots
+    ParameterSnapshot parameters;
+    parameterReader.read(parameters);
+    PatchState::write(parameters, destData);
 }
 
 void TapSynthAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    // Restoring only sets the parameters, the voices stay as they are and pick up the new values on the next block like any other change
+    ParameterSnapshot parameters;
+    std::bitset<ParameterSnapshot::numParameters> isPresent;
+    
+    // Versions before the binary format saved nothing at all, so an empty state is a patch with every parameter at its default
+    if(data == nullptr || sizeInBytes <= 0){
+        parameterWriter.write(parameters, isPresent);
+        return;
+    }
+    
+    // Not something we can read, whether it's another plugin's or from a newer TapSynth: leave the current patch alone rather than guess
+    if(! PatchState::read(data, (size_t) sizeInBytes, parameters, isPresent))
+        return;
+    
+    // Parameters that didn't exist yet when the state was saved go back to their defaults, and the rest are clamped to their ranges
+    parameterWriter.write(parameters, isPresent);
 }
 
 //==============================================================================
 // This creates new instances of the plugin..
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
 {
-    return new TapSynthAudioProcessor();
+    return new TapSynthAudioProcessor(SynthEngine::defaultNumVoices, TapSynthAudioProcessor::getDefaultPresetBankFile());
 }
 
 juce::AudioProcessorValueTreeState::ParameterLayout TapSynthAudioProcessor::createParams()
@@ -269,9 +436,19 @@ juce::AudioProcessorValueTreeState::ParameterLayout TapSynthAudioProcessor::crea
     
     
     // Filter
-    params.push_back(std::make_unique<juce::AudioParameterChoice> (juce::ParameterID {"FILTERTYPE",  1 }, "Filter Type", juce::StringArray {"Low-Pass", "Band-Pass", "High-Pass"}, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice> (juce::ParameterID {"FILTERTYPE",  1 }, "Filter Type", juce::StringArray {"Low-Pass", "Band-Pass", "High-Pass", "Low-Pass 24", "Ladder"}, 0));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID {"FILTERFREQ",  1 }, "Filter Freq",  juce::NormalisableRange<float> {20.0f, 20000.0f, 0.1f, 0.6f}, 200.0f));
     params.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID {"FILTERRES",  1 }, "Filter Resonance",  juce::NormalisableRange<float> {1.0f, 10.0f, 0.1f, }, 1.0f));
     
+    // Voice pan: spreads notes across the stereo field by pitch
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(juce::ParameterID {"PANSPREAD",  1 }, "Pan Spread",  juce::NormalisableRange<float> {0.0f, 1.0f, 0.01f, }, 0.0f));
+    
+    // Voice stealing: which playing voice a new note takes over when they're all busy, in VoiceAllocator::StealPolicy order
+    params.push_back(std::make_unique<juce::AudioParameterChoice> (juce::ParameterID {"VOICESTEAL",  1 }, "Voice Stealing", juce::StringArray {"Oldest", "Quietest", "Same Note", "Released First"}, 3));
+    
+    // Oversampling of the voices: one setting for playing in real time, another for offline renders
+    params.push_back(std::make_unique<juce::AudioParameterChoice> (juce::ParameterID {"OVERSAMPLING",  1 }, "Oversampling", juce::StringArray {"Off", "2x", "4x"}, 0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice> (juce::ParameterID {"OFFLINEOVERSAMPLING",  1 }, "Offline Oversampling", juce::StringArray {"Off", "2x", "4x"}, 2));
+    
     return {params.begin(), params.end()};
 }
@@ -11,15 +11,25 @@
 #include <JuceHeader.h>
 #include "SynthVoice.h"
 #include "SynthSound.h"
+#include "SynthEngine.h"
+#include "ParameterSnapshot.h"
+#include "PatchState.h"
+#include "PresetBank.h"
+#include "CpuLoadMeter.h"
+#include "AnalyserFifo.h"
 
 //==============================================================================
 /**
 */
-class TapSynthAudioProcessor  : public juce::AudioProcessor
+class TapSynthAudioProcessor  : public juce::AudioProcessor,
+                                private juce::Timer
 {
 public:
     //==============================================================================
-    TapSynthAudioProcessor();
+    // numVoices sets the polyphony, from 1 up to SynthEngine::maxVoices.
+    // presetBankFile is loaded if it exists. The plugin passes getDefaultPresetBankFile(), everything else leaves it empty
+    // so that what it plays doesn't depend on the bank of whoever runs it
+    explicit TapSynthAudioProcessor (int numVoices = SynthEngine::defaultNumVoices, const juce::File& presetBankFile = {});
     ~TapSynthAudioProcessor() override;
 
     //==============================================================================
@@ -54,6 +64,20 @@ public:
     //==============================================================================
     void getStateInformation (juce::MemoryBlock& destData) override;
     void setStateInformation (const void* data, int sizeInBytes) override;
+
+    // Maps a preset bank file and makes its programs the processor's programs. Message thread only
+    bool loadPresetBank (const juce::File& file);
+    static juce::File getDefaultPresetBankFile();
+
+    // Puts the processor back where a new piece of MIDI starts: no notes playing, no bank selected and no program change waiting.
+    // Hosts don't need it, it's for tools that play one piece after another through the same processor. Call it between blocks
+    void resetPlaybackState();
+
+    //==============================================================================
+    int getNumVoices() const noexcept { return synth.getNumVoices(); }
+    SynthEngine& getSynth() noexcept { return synth; }
+    const CpuLoadMeter& getCpuLoadMeter() const noexcept { return cpuLoadMeter; }
+    AnalyserFifo& getAnalyserFifo() noexcept { return analyserFifo; }
     
     juce::AudioProcessorValueTreeState treeState;
 
@@ -62,7 +86,38 @@ private:
     // Here we use a AudioProcessorValueTreeState for a combobox and ADSR controls
     juce::AudioProcessorValueTreeState::ParameterLayout createParams();
     
-    juce::Synthesiser synth;
+    SynthEngine synth;
+    
+    // How close each block comes to its deadline, for the editor's meter
+    CpuLoadMeter cpuLoadMeter;
+    
+    // The output on its way to the editor's scope and spectrum
+    AnalyserFifo analyserFifo;
+
+    // The parameter atomics are looked up once, and each block only pushes the groups of parameters that changed to the voices
+    ParameterSnapshotReader parameterReader;
+    ParameterSnapshotWriter parameterWriter;
+    ParameterSnapshot lastParameters;
+    juce::uint32 parameterGroupsToPush { ParameterSnapshot::allGroups };
+    
+    void readParameters (const PresetBank::Bank* bank);
+    void pushChangedParametersToVoices();
+
+    // Program changes reach the audio thread as the ID of a program that's already been decoded, so the next block switches
+    // to the whole patch at once. Until the message thread has written that program into treeState,
+    // the audio thread keeps playing the program rather than the parameters
+    PresetBank presetBank;
+    std::atomic<juce::uint64> pendingProgram { 0 };
+    std::atomic<int> currentProgram { 0 };
+    std::map<int, juce::String> renamedPrograms;
+
+    // MIDI bank select, which picks the group of 128 programs that program change messages choose from
+    int bankSelectMsb { 0 };
+    int bankSelectLsb { 0 };
+
+    void handleProgramChanges (const juce::MidiBuffer& midiMessages, const PresetBank::Bank* bank) noexcept;
+    void applyProgram (juce::uint64 programId);
+    void timerCallback() override;
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (TapSynthAudioProcessor)
 };
@@ -0,0 +1,157 @@
+/*
+  ==============================================================================
+
+    PresetBank.cpp
+    Created: 17 Oct 2026 4:37:15pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "PresetBank.h"
+
+juce::String PresetBank::Bank::getProgramName (int programIndex) const
+{
+    if (! juce::isPositiveAndBelow (programIndex, getNumPrograms()))
+        return {};
+
+    const auto* name = index + (size_t) programIndex * indexEntrySize;
+    size_t length = 0;
+
+    while (length < (size_t) maxNameBytes && name[length] != 0)
+        ++length;
+
+    return juce::String::fromUTF8 (name, (int) length);
+}
+
+const ParameterSnapshot* PresetBank::Bank::findProgram (juce::uint64 programId) const noexcept
+{
+    const auto programIndex = getProgramIndex (programId);
+
+    if ((juce::uint32) (programId >> 32) != generation || ! juce::isPositiveAndBelow (programIndex, getNumPrograms()))
+        return nullptr;
+
+    return &programs[(size_t) programIndex];
+}
+
+//==============================================================================
+bool PresetBank::load (const juce::File& file, const ParameterSnapshotWriter& parameters)
+{
+    auto bank = std::make_unique<Bank>();
+    bank->file = std::make_unique<juce::MemoryMappedFile> (file, juce::MemoryMappedFile::readOnly);
+
+    const auto* data = static_cast<const char*> (bank->file->getData());
+    const auto size = bank->file->getSize();
+
+    if (data == nullptr || size < headerSize || std::memcmp (data, magic, sizeof (magic)) != 0)
+        return false;
+
+    const auto numPrograms = (size_t) (juce::uint32) juce::ByteOrder::littleEndianInt (data + 8);
+
+    if ((size - headerSize) / indexEntrySize < numPrograms)
+        return false;
+
+    ParameterSnapshot defaults;
+    parameters.readDefaults (defaults);
+
+    bank->index = data + headerSize;
+    bank->programs.resize (numPrograms, defaults);
+
+    for (size_t i = 0; i < numPrograms; ++i)
+    {
+        const auto* entry = bank->index + i * indexEntrySize + maxNameBytes;
+        const auto offset = (size_t) (juce::uint32) juce::ByteOrder::littleEndianInt (entry);
+        const auto length = (size_t) (juce::uint32) juce::ByteOrder::littleEndianInt (entry + 4);
+
+        std::bitset<ParameterSnapshot::numParameters> isPresent;
+
+        if (offset > size || size - offset < length
+             || ! PatchState::read (data + offset, length, bank->programs[i], isPresent))
+            return false;
+
+        parameters.sanitise (bank->programs[i]);
+    }
+
+    bank->generation = nextGeneration++;
+
+    // From here on the audio thread can pick up the new bank. The old one stays around until it's known to be unused
+    currentBank.store (bank.get());
+    banks.push_back (std::move (bank));
+    releaseRetiredBanks();
+    return true;
+}
+
+bool PresetBank::write (const juce::File& file, const std::vector<Preset>& presets)
+{
+    juce::MemoryOutputStream stream;
+    stream.write (magic, sizeof (magic));
+    stream.writeShort ((short) currentVersion);
+    stream.writeShort (0);
+    stream.writeInt ((int) presets.size());
+
+    juce::MemoryBlock state;
+    auto offset = headerSize + presets.size() * indexEntrySize;
+
+    for (auto& preset : presets)
+    {
+        char name[maxNameBytes] {};
+        preset.name.copyToUTF8 (name, sizeof (name));
+
+        PatchState::write (preset.parameters, state);
+
+        stream.write (name, sizeof (name));
+        stream.writeInt ((int) offset);
+        stream.writeInt ((int) state.getSize());
+        offset += state.getSize();
+    }
+
+    for (auto& preset : presets)
+    {
+        PatchState::write (preset.parameters, state);
+        stream.write (state.getData(), state.getSize());
+    }
+
+    // Write to a temporary file first, so a bank that other instances have mapped is never seen half written
+    juce::TemporaryFile temporaryFile (file);
+
+    if (! temporaryFile.getFile().replaceWithData (stream.getData(), stream.getDataSize()))
+        return false;
+
+    return temporaryFile.overwriteTargetFileWithTemporary();
+}
+
+//==============================================================================
+const PresetBank::Bank* PresetBank::getBankForAudioThread() noexcept
+{
+    // Announce the bank we're about to use, then check it's still current. If the message thread swapped banks in between
+    // it may not have seen our announcement, so go round again with the new one
+    auto* bank = currentBank.load();
+
+    for (;;)
+    {
+        bankInUseByAudioThread.store (bank);
+        auto* latest = currentBank.load();
+
+        if (latest == bank)
+            return bank;
+
+        bank = latest;
+    }
+}
+
+void PresetBank::releaseRetiredBanks()
+{
+    const auto* current = currentBank.load();
+    const auto* inUse = bankInUseByAudioThread.load();
+
+    banks.erase (std::remove_if (banks.begin(), banks.end(), [&] (const std::unique_ptr<Bank>& bank)
+                                 {
+                                     return bank.get() != current && bank.get() != inUse;
+                                 }),
+                 banks.end());
+}
+
+juce::uint64 PresetBank::makeProgramId (const Bank& bank, int index) noexcept
+{
+    return ((juce::uint64) bank.generation << 32) | (juce::uint32) index;
+}
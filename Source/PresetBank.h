@@ -0,0 +1,91 @@
+/*
+  ==============================================================================
+
+    PresetBank.h
+    Created: 17 Oct 2026 4:37:15pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "ParameterSnapshot.h"
+#include "PatchState.h"
+
+// A bank of programs, read from a file that is memory-mapped rather than copied into memory. The layout is little-endian:
+//
+//   magic        4 bytes, "TSbk"
+//   version      uint16, currentVersion when written
+//   reserved     uint16, zero
+//   numPrograms  uint32
+//   index        numPrograms times { 32 byte UTF-8 name, zero padded; uint32 offset; uint32 size }
+//   programs     the PatchState of every program, at the offset and with the size given in its index entry
+//
+// Every program is decoded into a ParameterSnapshot when the bank loads, so switching programs later is just a matter of
+// picking one. The names stay in the mapped file and are only read when something asks for them.
+class PresetBank
+{
+public:
+    static constexpr juce::uint16 currentVersion = 1;
+    static constexpr int maxNameBytes = 32;
+
+    struct Preset
+    {
+        juce::String name;
+        ParameterSnapshot parameters;
+    };
+
+    // One loaded bank file. Banks are never changed once loaded, a new file gets a new Bank with a new generation
+    struct Bank
+    {
+        int getNumPrograms() const noexcept { return (int) programs.size(); }
+        juce::String getProgramName (int index) const;
+
+        // Returns nullptr if the ID doesn't belong to this bank
+        const ParameterSnapshot* findProgram (juce::uint64 programId) const noexcept;
+
+        juce::uint32 generation { 0 };
+        std::vector<ParameterSnapshot> programs;
+        std::unique_ptr<juce::MemoryMappedFile> file;
+        const char* index { nullptr };
+    };
+
+    PresetBank() = default;
+
+    // Message thread only. Programs in the file that leave parameters out get their defaults, and every value is sanitised
+    // against the parameters' ranges, since the audio thread plays programs as they are.
+    // Returns false and keeps the current bank if the file can't be mapped or isn't a valid bank
+    bool load (const juce::File& file, const ParameterSnapshotWriter& parameters);
+
+    static bool write (const juce::File& file, const std::vector<Preset>& presets);
+
+    // The bank most recently loaded, or nullptr. Message thread only
+    const Bank* getBank() const noexcept { return currentBank.load(); }
+
+    // The audio thread's view of the current bank. Call it once at the start of every block and use the result until the end of it:
+    // a bank the audio thread might still be using is never freed, so this needs no locks
+    const Bank* getBankForAudioThread() noexcept;
+
+    // Frees banks that have been replaced, once the audio thread is done with them. Message thread only
+    void releaseRetiredBanks();
+
+    // Identifies one program of one particular bank, packed to fit through a single atomic. Zero never identifies a program
+    static juce::uint64 makeProgramId (const Bank& bank, int index) noexcept;
+    static int getProgramIndex (juce::uint64 programId) noexcept { return (int) (programId & 0xffffffff); }
+
+private:
+    static constexpr char magic[4] { 'T', 'S', 'b', 'k' };
+    static constexpr size_t headerSize = 12;
+    static constexpr size_t indexEntrySize = (size_t) maxNameBytes + 8;
+
+    std::atomic<const Bank*> currentBank { nullptr };
+    std::atomic<const Bank*> bankInUseByAudioThread { nullptr };
+
+    // Owns the current bank and any replaced ones that haven't been released yet
+    std::vector<std::unique_ptr<Bank>> banks;
+    juce::uint32 nextGeneration { 1 };
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (PresetBank)
+};
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    StageProfiler.cpp
+    Created: 18 Oct 2026 2:48:36am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "StageProfiler.h"
+
+#if TAPSYNTH_PROFILING
+const char* StageTimes::getStageName (int stage) noexcept
+{
+    static constexpr const char* names[numStages]
+    {
+        "oscillator",
+        "fmModulator",
+        "ampEnvelope",
+        "modEnvelope",
+        "filter",
+        "gain",
+        "mixToOutput"
+    };
+
+    jassert (juce::isPositiveAndBelow (stage, (int) numStages));
+    return names[stage];
+}
+
+bool StageTimes::isEmpty() const noexcept
+{
+    for (auto stageCycles : cycles)
+        if (stageCycles != 0)
+            return false;
+
+    return true;
+}
+
+//==============================================================================
+StageProfiler::StageProfiler (int capacity)
+    : fifo (juce::jmax (2, capacity)),
+      records ((size_t) juce::jmax (2, capacity))
+{
+}
+
+void StageProfiler::push (juce::uint32 block, int voice, int numSamples, const StageTimes& times) noexcept
+{
+    const auto scope = fifo.write (1);
+
+    if (scope.blockSize1 + scope.blockSize2 == 0)
+    {
+        numDropped.fetch_add (1, std::memory_order_relaxed);
+        return;
+    }
+
+    auto& record = records[(size_t) (scope.blockSize1 > 0 ? scope.startIndex1 : scope.startIndex2)];
+    record.block = block;
+    record.voice = voice;
+    record.numSamples = numSamples;
+    record.cycles = times.cycles;
+}
+
+int StageProfiler::pop (Record* destination, int maxRecords) noexcept
+{
+    const auto scope = fifo.read (juce::jmax (0, maxRecords));
+
+    std::copy_n (records.begin() + scope.startIndex1, scope.blockSize1, destination);
+    std::copy_n (records.begin() + scope.startIndex2, scope.blockSize2, destination + scope.blockSize1);
+
+    return scope.blockSize1 + scope.blockSize2;
+}
+
+void StageProfiler::writeCsvHeader (juce::OutputStream& stream)
+{
+    stream << "block,voice,samples";
+
+    for (int stage = 0; stage < StageTimes::numStages; ++stage)
+        stream << "," << StageTimes::getStageName (stage);
+
+    stream << "\n";
+}
+
+void StageProfiler::writeCsv (juce::OutputStream& stream, const Record* records, int numRecords)
+{
+    for (int i = 0; i < numRecords; ++i)
+    {
+        const auto& record = records[i];
+        stream << (juce::int64) record.block << "," << record.voice << "," << record.numSamples;
+
+        for (auto stageCycles : record.cycles)
+            stream << "," << (juce::int64) stageCycles;
+
+        stream << "\n";
+    }
+}
+
+void StageProfiler::writeJson (juce::OutputStream& stream, const Record* records, int numRecords)
+{
+    for (int i = 0; i < numRecords; ++i)
+    {
+        const auto& record = records[i];
+        stream << "{\"block\":" << (juce::int64) record.block << ",\"voice\":" << record.voice << ",\"samples\":" << record.numSamples;
+
+        for (int stage = 0; stage < StageTimes::numStages; ++stage)
+            stream << ",\"" << StageTimes::getStageName (stage) << "\":" << (juce::int64) record.cycles[(size_t) stage];
+
+        stream << "}\n";
+    }
+}
+#endif
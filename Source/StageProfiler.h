@@ -0,0 +1,153 @@
+/*
+  ==============================================================================
+
+    StageProfiler.h
+    Created: 18 Oct 2026 2:48:36am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Per-stage timing of the voices, for finding out where a block's time goes on a slow machine.
+// It only exists in builds configured with TAPSYNTH_PROFILING (never in Release builds, see CMakeLists.txt).
+// Everywhere else the TAPSYNTH_PROFILE_ macros are empty and none of the classes below are declared
+#ifndef TAPSYNTH_PROFILING
+ #define TAPSYNTH_PROFILING 0
+#endif
+
+#if TAPSYNTH_PROFILING
+
+#if JUCE_INTEL
+ #if JUCE_MSVC
+  #include <intrin.h>
+ #else
+  #include <x86intrin.h>
+ #endif
+#endif
+
+// The CPU's cycle counter where there's one to read cheaply (the TSC on x86, the virtual counter on 64-bit ARM),
+// otherwise the high resolution tick count. Only differences between two readings on the same thread mean anything
+inline juce::uint64 readCycleCounter() noexcept
+{
+   #if JUCE_INTEL
+    return (juce::uint64) __rdtsc();
+   #elif JUCE_ARM && JUCE_64BIT && ! JUCE_MSVC
+    juce::uint64 ticks;
+    asm volatile ("mrs %0, cntvct_el0" : "=r" (ticks));
+    return ticks;
+   #else
+    return (juce::uint64) juce::Time::getHighResolutionTicks();
+   #endif
+}
+
+// The cycles one voice spent in each stage of its render, summed over a block. Every voice has one
+struct StageTimes
+{
+    enum Stage
+    {
+        oscillator,
+        fmModulator,        // the FM modulator and the carrier's per-sample phase increments
+        ampEnvelope,
+        modEnvelope,
+        filter,             // the cutoff's control points as well as the filtering
+        gain,               // the fade of a stolen note, or setting up a group's gains
+        mixToOutput,        // panning the voice into the output channels
+        numStages
+    };
+
+    static const char* getStageName (int stage) noexcept;
+
+    void clear() noexcept           { cycles.fill (0); }
+    bool isEmpty() const noexcept;
+
+    std::array<juce::uint64, (size_t) numStages> cycles {};
+};
+
+// Adds the cycles from its construction to its destruction to a stage. A stage that a VoiceBatchRenderer runs for a
+// whole group at once is charged to each of the group's voices in equal parts
+class ScopedStageTimer
+{
+public:
+    ScopedStageTimer (StageTimes& voiceTimes, StageTimes::Stage stageToTime) noexcept
+        : single (&voiceTimes), times (&single), numTimes (1), stage (stageToTime), start (readCycleCounter())
+    {
+    }
+
+    ScopedStageTimer (StageTimes* const* groupTimes, int numVoices, StageTimes::Stage stageToTime) noexcept
+        : times (groupTimes), numTimes (numVoices), stage (stageToTime), start (readCycleCounter())
+    {
+    }
+
+    ~ScopedStageTimer() noexcept
+    {
+        const auto share = (readCycleCounter() - start) / (juce::uint64) numTimes;
+
+        for (int i = 0; i < numTimes; ++i)
+            times[i]->cycles[(size_t) stage] += share;
+    }
+
+private:
+    StageTimes* single { nullptr };
+    StageTimes* const* times;
+    int numTimes;
+    StageTimes::Stage stage;
+    juce::uint64 start;
+
+    JUCE_DECLARE_NON_COPYABLE (ScopedStageTimer)
+};
+
+// Carries the stage times from the audio thread to whoever looks at them, one record per voice that played in a block.
+// There's a single writer (the thread that renders the engine's blocks) and a single reader (an editor, or a tool that
+// writes the records to a file), and neither ever waits for the other: records that don't fit are dropped and counted
+class StageProfiler
+{
+public:
+    struct Record
+    {
+        juce::uint32 block;     // counts the engine's blocks, including those with nothing playing
+        int voice;              // the voice's index in the pool
+        int numSamples;         // the block's length at the host's rate
+        std::array<juce::uint64, (size_t) StageTimes::numStages> cycles;
+    };
+
+    explicit StageProfiler (int capacity = 16384);
+
+    // Audio thread only. Never allocates or blocks
+    void push (juce::uint32 block, int voice, int numSamples, const StageTimes& times) noexcept;
+
+    // The reader's side. Returns how many records were copied into destination
+    int pop (Record* destination, int maxRecords) noexcept;
+
+    // How many records haven't been read yet, and how many were dropped since the profiler was created
+    int getNumReady() const noexcept                    { return fifo.getNumReady(); }
+    juce::uint64 getNumDropped() const noexcept         { return numDropped.load (std::memory_order_relaxed); }
+
+    // CSV with a header row and one row per record, or JSON Lines with one object per record
+    static void writeCsvHeader (juce::OutputStream& stream);
+    static void writeCsv (juce::OutputStream& stream, const Record* records, int numRecords);
+    static void writeJson (juce::OutputStream& stream, const Record* records, int numRecords);
+
+private:
+    juce::AbstractFifo fifo;
+    std::vector<Record> records;
+    std::atomic<juce::uint64> numDropped { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE (StageProfiler)
+};
+
+ #define TAPSYNTH_PROFILE_STAGE(voiceTimes, stage) \
+    const ScopedStageTimer JUCE_JOIN_MACRO (stageTimer, __LINE__) (voiceTimes, StageTimes::stage)
+
+ #define TAPSYNTH_PROFILE_GROUP_STAGE(groupTimes, numVoices, stage) \
+    const ScopedStageTimer JUCE_JOIN_MACRO (stageTimer, __LINE__) (groupTimes, numVoices, StageTimes::stage)
+
+#else
+
+ #define TAPSYNTH_PROFILE_STAGE(voiceTimes, stage)
+ #define TAPSYNTH_PROFILE_GROUP_STAGE(groupTimes, numVoices, stage)
+
+#endif
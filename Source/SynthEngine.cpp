@@ -0,0 +1,403 @@
+/*
+  ==============================================================================
+
+    SynthEngine.cpp
+    Created: 17 Oct 2026 11:04:51am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "SynthEngine.h"
+
+SynthEngine::SynthEngine (int numVoices)
+    : voicePool (numVoices),
+      allocator (voicePool.size()),
+      batchRenderers ((size_t) workerPool->getNumParticipants())
+{
+    // The base class only gets pointers into the pool, the pool itself keeps ownership of the voices
+    for (auto& voice : voicePool)
+    {
+        addVoice (&voice);
+        voice.setEventOffsetSource (&eventOffset);
+    }
+}
+
+SynthEngine::~SynthEngine()
+{
+    // juce::Synthesiser deletes every voice it holds when it is destroyed, but ours belong to the pool
+    voices.clear (false);
+}
+
+void SynthEngine::prepareToPlay (double sampleRate, int samplesPerBlock)
+{
+    setCurrentPlaybackSampleRate (sampleRate);
+
+    hostSampleRate = sampleRate;
+    maxBlockSize = juce::jmax (1, samplesPerBlock);
+    chunkSize = juce::jlimit (1, maxBlockSize, requestedChunkSize);
+
+    // The voices' buffers are sized for the highest oversampling factor, whichever one is in use now
+    const auto maxVoiceBlockSize = maxBlockSize * HalfBandDecimator::maxFactor;
+
+    for (auto& renderer : batchRenderers)
+        renderer.prepare (maxVoiceBlockSize);
+
+    // There are never more jobs than voices
+    jobBuffers.setSize (2 * voicePool.size(), maxVoiceBlockSize);
+    auto* const* channels = jobBuffers.getArrayOfWritePointers();
+    jobChannels.assign (channels, channels + jobBuffers.getNumChannels());
+
+    oversampledMix.setSize ((int) decimators.size(), maxVoiceBlockSize);
+
+    for (auto& decimator : decimators)
+        decimator.setFactor (oversamplingFactor);
+
+    for (auto& voice : voicePool)
+        voice.prepareToPlay (sampleRate * oversamplingFactor, maxVoiceBlockSize);
+}
+
+void SynthEngine::reset() noexcept
+{
+    const juce::ScopedLock sl (lock);
+
+    for (auto& voice : voicePool)
+        voice.reset();
+
+    // The base class keeps the sustain pedals and pitch wheels per channel, which would carry over just the same
+    for (int channel = 1; channel <= 16; ++channel)
+    {
+        juce::Synthesiser::handleSustainPedal (channel, false);
+        lastPitchWheelValues[channel - 1] = 0x2000;
+    }
+
+    updateAllocatorFromVoices();
+
+    for (auto& decimator : decimators)
+        decimator.reset();
+}
+
+void SynthEngine::setMultiCoreRendering (bool shouldUseWorkers)
+{
+    if (shouldUseWorkers)
+        workerPool->startWorkers();
+
+    multiCoreRendering.store (shouldUseWorkers);
+}
+
+void SynthEngine::setOversamplingFactor (int factor) noexcept
+{
+    jassert (factor == 1 || factor == 2 || factor == HalfBandDecimator::maxFactor);
+    factor = juce::jlimit (1, HalfBandDecimator::maxFactor, juce::nextPowerOfTwo (factor));
+
+    if (factor == oversamplingFactor)
+        return;
+
+    oversamplingFactor = factor;
+
+    // Before prepareToPlay there's nothing to change, it picks the factor up itself
+    if (maxBlockSize == 0)
+        return;
+
+    // Playing notes carry on at the new rate. Only the decimators start over, which is no worse than the step in the
+    // top octave that switching makes anyway
+    for (auto& decimator : decimators)
+        decimator.setFactor (oversamplingFactor);
+
+    for (auto& voice : voicePool)
+        voice.setSampleRate (hostSampleRate * oversamplingFactor);
+}
+
+void SynthEngine::setChunkSize (int numSamples) noexcept
+{
+    requestedChunkSize = juce::jmax (1, numSamples);
+    chunkSize = juce::jlimit (1, juce::jmax (1, maxBlockSize), requestedChunkSize);
+}
+
+void SynthEngine::setEventGranularity (int numSamples) noexcept
+{
+    eventGranularity = juce::jmax (1, numSamples);
+}
+
+void SynthEngine::renderNextBlock (juce::AudioBuffer<float>& outputAudio, const juce::MidiBuffer& midiData, int startSample, int numSamples)
+{
+    // prepareToPlay has to be called first
+    jassert (getSampleRate() != 0 && maxBlockSize > 0);
+
+    if (maxBlockSize == 0)
+        return;
+
+    const juce::ScopedLock sl (lock);
+
+   #if TAPSYNTH_PROFILING
+    ++numProfiledBlocks;
+   #endif
+
+    auto event = midiData.findNextSamplePosition (startSample);
+    const auto endSample = startSample + numSamples;
+
+    // Every voice is asleep and nothing will wake one up, so the output is left as it is
+    if (! isSounding() && (event == midiData.end() || (*event).samplePosition >= endSample))
+        return;
+
+    for (auto chunkStart = startSample; chunkStart < endSample; chunkStart += chunkSize)
+    {
+        const auto chunkLength = juce::jmin (chunkSize, endSample - chunkStart);
+
+        // Voices queue what these events do to them and apply it at eventOffset when the chunk is rendered
+        for (; event != midiData.end(); ++event)
+        {
+            const auto metadata = *event;
+
+            if (metadata.samplePosition >= chunkStart + chunkLength)
+                break;
+
+            const auto offset = metadata.samplePosition - chunkStart;
+            eventOffset = (offset - offset % eventGranularity) * oversamplingFactor;
+            handleMidiEvent (metadata.getMessage());
+        }
+
+        eventOffset = 0;
+        renderVoices (outputAudio, chunkStart, chunkLength);
+    }
+
+   #if TAPSYNTH_PROFILING
+    collectStageTimes (numSamples);
+   #endif
+}
+
+#if TAPSYNTH_PROFILING
+void SynthEngine::collectStageTimes (int numSamples) noexcept
+{
+    // Voices that went to sleep during the block still have its times, so this looks at the whole pool
+    for (int voice = 0; voice < voicePool.size(); ++voice)
+    {
+        auto& times = voicePool[voice].getStageTimes();
+
+        if (times.isEmpty())
+            continue;
+
+        stageProfiler.push (numProfiledBlocks, voice, numSamples, times);
+        times.clear();
+    }
+}
+#endif
+
+void SynthEngine::noteOn (int midiChannel, int midiNoteNumber, float velocity)
+{
+    const juce::ScopedLock sl (lock);
+
+    for (auto* sound : sounds)
+    {
+        if (! sound->appliesToNote (midiNoteNumber) || ! sound->appliesToChannel (midiChannel))
+            continue;
+
+        auto voice = VoiceAllocator::noVoice;
+
+        // If the note is still ringing (because of its release or the pedals) it's stopped first, like juce::Synthesiser does.
+        // The same note policy retriggers its newest voice instead
+        for (auto index = allocator.getFirstVoiceForNote (midiChannel, midiNoteNumber); index != VoiceAllocator::noVoice;)
+        {
+            const auto next = allocator.getNextVoiceForNote (index);
+
+            if (stealPolicy == VoiceAllocator::StealPolicy::sameNote && voice == VoiceAllocator::noVoice)
+            {
+                voice = index;
+            }
+            else
+            {
+                stopVoice (&voicePool[index], 1.0f, true);
+                voiceStopped (index);
+            }
+
+            index = next;
+        }
+
+        if (voice == VoiceAllocator::noVoice)
+            voice = allocator.takeFreeVoice();
+
+        if (voice == VoiceAllocator::noVoice && isNoteStealingEnabled())
+            voice = allocator.findVoiceToSteal (stealPolicy, midiChannel, midiNoteNumber);
+
+        if (voice != VoiceAllocator::noVoice)
+        {
+            startVoice (&voicePool[voice], sound, midiChannel, midiNoteNumber, velocity);
+            allocator.voiceStarted (voice, midiChannel, midiNoteNumber);
+        }
+    }
+}
+
+void SynthEngine::noteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    const juce::ScopedLock sl (lock);
+
+    // Only the voices of this note are visited, not the whole pool
+    for (auto index = allocator.getFirstVoiceForNote (midiChannel, midiNoteNumber); index != VoiceAllocator::noVoice;)
+    {
+        const auto next = allocator.getNextVoiceForNote (index);
+        auto& voice = voicePool[index];
+
+        if (voice.isKeyDown())
+        {
+            voice.setKeyDown (false);
+
+            if (! (voice.isSustainPedalDown() || voice.isSostenutoPedalDown()))
+            {
+                stopVoice (&voice, velocity, allowTailOff);
+                voiceStopped (index);
+            }
+        }
+
+        index = next;
+    }
+}
+
+void SynthEngine::allNotesOff (int midiChannel, bool allowTailOff)
+{
+    const juce::ScopedLock sl (lock);
+
+    juce::Synthesiser::allNotesOff (midiChannel, allowTailOff);
+    updateAllocatorFromVoices();
+}
+
+void SynthEngine::handleSustainPedal (int midiChannel, bool isDown)
+{
+    const juce::ScopedLock sl (lock);
+
+    juce::Synthesiser::handleSustainPedal (midiChannel, isDown);
+    updateAllocatorFromVoices();
+}
+
+void SynthEngine::handleSostenutoPedal (int midiChannel, bool isDown)
+{
+    const juce::ScopedLock sl (lock);
+
+    juce::Synthesiser::handleSostenutoPedal (midiChannel, isDown);
+    updateAllocatorFromVoices();
+}
+
+void SynthEngine::voiceStopped (int voice) noexcept
+{
+    if (! voicePool[voice].isVoiceActive())
+        allocator.voiceFreed (voice);
+    else if (voicePool[voice].isPlayingButReleased())
+        allocator.voiceReleased (voice);
+}
+
+void SynthEngine::updateAllocatorFromVoices() noexcept
+{
+    // Pedals and all-notes-off are rare enough that looking at every voice is fine here
+    for (int voice = 0; voice < voicePool.size(); ++voice)
+        if (! allocator.isFree (voice))
+            voiceStopped (voice);
+}
+
+//==============================================================================
+void SynthEngine::renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    // The voices size their buffers for the block size given to prepareToPlay (at the highest oversampling factor).
+    // Some hosts still hand over longer blocks now and then, so those are rendered in pieces
+    while (numSamples > maxBlockSize)
+    {
+        renderVoices (outputAudio, startSample, maxBlockSize);
+        startSample += maxBlockSize;
+        numSamples -= maxBlockSize;
+    }
+
+    if (oversamplingFactor == 1)
+    {
+        renderActiveVoices (outputAudio, startSample, numSamples);
+        return;
+    }
+
+    // Every voice adds itself to the oversampled mix, then each channel of the mix is brought down to the host rate once
+    const auto numChannels = juce::jmin (outputAudio.getNumChannels(), oversampledMix.getNumChannels());
+
+    if (numChannels == 0)
+        return;
+
+    juce::AudioBuffer<float> mix (oversampledMix.getArrayOfWritePointers(), numChannels, numSamples * oversamplingFactor);
+    mix.clear();
+    renderActiveVoices (mix, 0, mix.getNumSamples());
+
+    for (int channel = 0; channel < numChannels; ++channel)
+        decimators[(size_t) channel].process (mix.getWritePointer (channel), outputAudio.getWritePointer (channel, startSample), numSamples);
+}
+
+void SynthEngine::renderActiveVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    // Walk the pool in memory order rather than going through the base class's array of pointers.
+    // Voices with events inside this chunk, or fading out a stolen note, can't join a SIMD group, so they go after the others
+    numActiveVoices = 0;
+
+    for (auto& voice : voicePool)
+        if (voice.isVoiceActive() && voice.canRenderInGroup())
+            activeVoices[(size_t) numActiveVoices++] = &voice;
+
+    const auto numLanes = VoiceBatchRenderer::numLanes;
+    numVoiceGroups = voiceParallelRendering ? numActiveVoices / numLanes : 0;
+
+    for (auto& voice : voicePool)
+        if (voice.isVoiceActive() && ! voice.canRenderInGroup())
+            activeVoices[(size_t) numActiveVoices++] = &voice;
+
+    // A job is either a full SIMD group or a single voice
+    const auto numJobs = numVoiceGroups + numActiveVoices - numVoiceGroups * numLanes;
+
+    if (multiCoreRendering.load (std::memory_order_relaxed) && numJobs > 1)
+    {
+        renderVoicesOnWorkers (outputAudio, startSample, numSamples, numJobs);
+    }
+    else
+    {
+        const auto numGroupedVoices = numVoiceGroups * numLanes;
+        batchRenderers.front().render (activeVoices.data(), numGroupedVoices, outputAudio, startSample, numSamples);
+
+        for (int i = numGroupedVoices; i < numActiveVoices; ++i)
+            activeVoices[(size_t) i]->renderNextBlock (outputAudio, startSample, numSamples);
+    }
+
+    // Hand the voices that finished back to the allocator, and give it the levels the quietest policy needs
+    for (int i = 0; i < numActiveVoices; ++i)
+    {
+        auto& voice = *activeVoices[(size_t) i];
+
+        if (voice.isVoiceActive())
+            allocator.setLevel (getVoiceIndex (voice), voice.getLevel());
+        else
+            allocator.voiceFreed (getVoiceIndex (voice));
+    }
+}
+
+void SynthEngine::renderVoicesOnWorkers (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples, int numJobs)
+{
+    jobNumSamples = numSamples;
+    jobNumChannels = juce::jmin (outputAudio.getNumChannels(), 2);
+
+    workerPool->run (&SynthEngine::renderJob, this, numJobs);
+
+    // The jobs are mixed in job order, which is also the order the single threaded path adds them in,
+    // so the result doesn't depend on which thread rendered what
+    for (int job = 0; job < numJobs; ++job)
+        for (int channel = 0; channel < jobNumChannels; ++channel)
+            juce::FloatVectorOperations::add (outputAudio.getWritePointer (channel, startSample), jobChannels[(size_t) (2 * job + channel)], numSamples);
+}
+
+void SynthEngine::renderJob (void* engine, int job, int participant)
+{
+    static_cast<SynthEngine*> (engine)->renderJob (job, participant);
+}
+
+void SynthEngine::renderJob (int job, int participant)
+{
+    juce::AudioBuffer<float> jobOutput (jobChannels.data() + 2 * job, jobNumChannels, jobNumSamples);
+    jobOutput.clear();
+
+    // The full groups come first, then the voices rendered one at a time, just like on the single threaded path
+    const auto numLanes = VoiceBatchRenderer::numLanes;
+
+    if (job < numVoiceGroups)
+        batchRenderers[(size_t) participant].render (activeVoices.data() + job * numLanes, numLanes, jobOutput, 0, jobNumSamples);
+    else
+        activeVoices[(size_t) (numVoiceGroups * numLanes + job - numVoiceGroups)]->renderNextBlock (jobOutput, 0, jobNumSamples);
+}
@@ -0,0 +1,159 @@
+/*
+  ==============================================================================
+
+    SynthEngine.h
+    Created: 17 Oct 2026 11:04:51am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SynthVoice.h"
+#include "VoicePool.h"
+#include "VoiceAllocator.h"
+#include "VoiceBatchRenderer.h"
+#include "HalfBandDecimator.h"
+#include "WorkStealingPool.h"
+#include "StageProfiler.h"
+
+// Our juce::Synthesiser. It holds a fixed number of voices that live in a VoicePool rather than being allocated one by one,
+// and gives the processor direct, typed access to them so nothing has to dynamic_cast its way to a SynthVoice.
+// Notes are assigned to voices by a VoiceAllocator instead of juce::Synthesiser's searches through every voice.
+class SynthEngine : public juce::Synthesiser
+{
+public:
+    static constexpr int defaultNumVoices = 32;
+    static constexpr int maxVoices = VoicePool::maxVoices;
+
+    explicit SynthEngine (int numVoices = defaultNumVoices);
+    ~SynthEngine() override;
+
+    void prepareToPlay (double sampleRate, int samplesPerBlock);
+
+    // Silences every voice at once and clears the decimators, so nothing that was playing carries over into what's rendered next.
+    // Unlike allNotesOff there's no fade, and it takes effect straight away rather than in the next block. Call it between blocks
+    void reset() noexcept;
+
+    VoicePool& getVoicePool() noexcept { return voicePool; }
+
+    // False once every voice has gone to sleep, and then there's nothing to render until the next note
+    bool isSounding() const noexcept    { return allocator.getNumBusyVoices() > 0; }
+
+    // Used instead of juce::Synthesiser::renderNextBlock, which renders up to every MIDI event and so breaks blocks with busy MIDI
+    // into slivers of a few samples. This renders the voices in chunks of a fixed size and handles the MIDI of each chunk up front.
+    // The voices then apply the events at their exact samples, and only the voices an event affects have their chunk split
+    void renderNextBlock (juce::AudioBuffer<float>& outputAudio, const juce::MidiBuffer& midiData, int startSample, int numSamples);
+
+    // The number of samples rendered between looking at the MIDI, capped at the block size given to prepareToPlay.
+    // Shorter chunks make voices that finish free up sooner, longer ones cost less per block
+    void setChunkSize (int numSamples) noexcept;
+    int getChunkSize() const noexcept                  { return chunkSize; }
+
+    // Events are moved back to a multiple of this many samples into their chunk. 1, the default, keeps them sample-accurate
+    void setEventGranularity (int numSamples) noexcept;
+    int getEventGranularity() const noexcept           { return eventGranularity; }
+
+    // With voice-parallel rendering on (the default), playing voices are rendered in SIMD groups by a VoiceBatchRenderer.
+    // Turning it off renders every voice on its own, which is mainly useful for comparing the two
+    void setVoiceParallelRendering (bool shouldRenderInParallel) noexcept   { voiceParallelRendering = shouldRenderInParallel; }
+    bool isVoiceParallelRendering() const noexcept                         { return voiceParallelRendering; }
+
+    // With multi-core rendering on, the voices are spread across the WorkStealingPool that every instance shares.
+    // Each job renders into its own buffer and the buffers are mixed in a fixed order, so the output is identical
+    // to rendering on one thread, whatever the number of cores. Turning it on starts the pool's workers if nothing has yet,
+    // so do that on the message thread. Turning it off, or on again once the workers are running, can be done from any thread
+    void setMultiCoreRendering (bool shouldUseWorkers);
+    bool isMultiCoreRendering() const noexcept                     { return multiCoreRendering.load(); }
+
+    // The voices can run at 2 or 4 times the host rate, so FM and resonant filter sweeps don't alias. They render into one
+    // oversampled mix, and only that mix goes through the HalfBandDecimator, however many voices are playing.
+    // factor is 1, 2 or 4. Call it between blocks, from the thread that renders them; it doesn't allocate
+    void setOversamplingFactor (int factor) noexcept;
+    int getOversamplingFactor() const noexcept                     { return oversamplingFactor; }
+
+    // Which voice a new note takes over when they're all busy. Stolen notes fade out over a few milliseconds first
+    void setStealPolicy (VoiceAllocator::StealPolicy newPolicy) noexcept    { stealPolicy = newPolicy; }
+    VoiceAllocator::StealPolicy getStealPolicy() const noexcept            { return stealPolicy; }
+
+   #if TAPSYNTH_PROFILING
+    // Each block, every voice that played leaves a record of the cycles it spent in each stage here.
+    // Read them from one thread that isn't rendering
+    StageProfiler& getStageProfiler() noexcept     { return stageProfiler; }
+   #endif
+
+    //==============================================================================
+    void noteOn (int midiChannel, int midiNoteNumber, float velocity) override;
+    void noteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+    void allNotesOff (int midiChannel, bool allowTailOff) override;
+    void handleSustainPedal (int midiChannel, bool isDown) override;
+    void handleSostenutoPedal (int midiChannel, bool isDown) override;
+
+protected:
+    using juce::Synthesiser::renderVoices;
+    void renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+
+private:
+    void renderActiveVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples);
+    void renderVoicesOnWorkers (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples, int numJobs);
+    void renderJob (int job, int participant);
+    static void renderJob (void* engine, int job, int participant);
+
+    int getVoiceIndex (const SynthVoice& voice) const noexcept    { return (int) (&voice - voicePool.begin()); }
+
+    // Lets the allocator know about voices that a stopVoice call freed or released
+    void voiceStopped (int voice) noexcept;
+
+    // For the base class's pedal and all-notes-off handling, which stops voices without telling us which
+    void updateAllocatorFromVoices() noexcept;
+
+    VoicePool voicePool;
+    VoiceAllocator allocator;
+    VoiceAllocator::StealPolicy stealPolicy { VoiceAllocator::StealPolicy::releasedFirst };
+    int maxBlockSize { 0 };
+    double hostSampleRate { 0.0 };
+
+    // Everything the voices render into is sized for the highest factor, so switching never allocates
+    int oversamplingFactor { 1 };
+    juce::AudioBuffer<float> oversampledMix;
+    std::array<HalfBandDecimator, 2> decimators;
+
+    static constexpr int defaultChunkSize = 128;
+    int requestedChunkSize { defaultChunkSize };
+    int chunkSize { defaultChunkSize };
+    int eventGranularity { 1 };
+
+    // Where, within the chunk being prepared, the MIDI event being handled falls, at the voices' rate. The voices read it through a pointer
+    int eventOffset { 0 };
+    bool voiceParallelRendering { true };
+    std::atomic<bool> multiCoreRendering { false };
+
+    juce::SharedResourcePointer<WorkStealingPool> workerPool;
+
+    // One renderer per pool participant, so every thread has its own lane buffers
+    std::vector<VoiceBatchRenderer> batchRenderers;
+
+    // A stereo output buffer for every job, and what the jobs of the current block need to know
+    juce::AudioBuffer<float> jobBuffers;
+    std::vector<float*> jobChannels;
+    int numActiveVoices { 0 };
+    int numVoiceGroups { 0 };
+    int jobNumSamples { 0 };
+    int jobNumChannels { 0 };
+
+   #if TAPSYNTH_PROFILING
+    StageProfiler stageProfiler;
+    juce::uint32 numProfiledBlocks { 0 };
+
+    // Moves the voices' stage times for the block into the profiler and starts them over
+    void collectStageTimes (int numSamples) noexcept;
+   #endif
+
+    // The voices that are playing in the current block, gathered without allocating.
+    // The first numVoiceGroups * VoiceBatchRenderer::numLanes of them are rendered in SIMD groups, the rest one at a time
+    std::array<SynthVoice*, (size_t) maxVoices> activeVoices {};
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SynthEngine)
+};
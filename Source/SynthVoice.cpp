@@ -16,15 +16,89 @@ bool SynthVoice::canPlaySound (juce::SynthesiserSound* sound){
 }
 
 void SynthVoice::startNote (int midiNoteNumber, float velocity, juce::SynthesiserSound* sound, int currentPitchWheelPosition){
+    queueEvent({ Event::start, 0, midiNoteNumber, velocity });
+}
+
+void SynthVoice::beginNote (int midiNoteNumber, float velocity){
     osc.setWaveFrequency(midiNoteNumber);
+    
+    // The parameter ramps only move while the voice renders, so a voice that's been silent could still be partway through one
+    if(! adsr.isActive()){
+        osc.skipParameterRamps();
+        filter.skipParameterRamps();
+    }
+    
+    // Spread the notes across the stereo field around middle C, using a constant power law that leaves a centred voice at unity
+    const auto pan = panSpread * juce::jlimit(-1.0f, 1.0f, (float) (midiNoteNumber - 60) / 48.0f);
+    const auto angle = (pan + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+    leftGain = juce::MathConstants<float>::sqrt2 * std::cos(angle);
+    rightGain = juce::MathConstants<float>::sqrt2 * std::sin(angle);
+    
     adsr.noteOn(); 
     modAdsr.noteOn();
 }
 
 void SynthVoice::stopNote (float velocity, bool allowTailOff){
-    adsr.noteOff();
-    modAdsr.noteOff();
-    if(! allowTailOff || ! adsr.isActive()) return clearCurrentNote();
+    queueEvent({ allowTailOff ? Event::release : Event::kill, 0, 0, velocity });
+}
+
+void SynthVoice::queueEvent (Event event){
+    // The engine handles all the MIDI of a chunk before rendering it, so the voice keeps its events until then and applies each one at its own sample
+    event.offset = eventOffsetSource != nullptr ? *eventOffsetSource : 0;
+    
+    // Only notes a handful of samples long can fill the queue. Those lose their timing, but not their order
+    if(numQueuedEvents == maxQueuedEvents){
+        for(int i = 0; i < numQueuedEvents; ++i)
+            applyEvent(queuedEvents[(size_t) i]);
+        
+        numQueuedEvents = 0;
+        event.offset = 0;
+    }
+    
+    queuedEvents[(size_t) numQueuedEvents++] = event;
+}
+
+void SynthVoice::applyEvent (const Event& event){
+    switch(event.type){
+        case Event::start:
+            // A stolen voice is still fading out its old note, so the new one starts once that's done
+            if(stealFadeRemaining > 0){
+                hasPendingNote = true;
+                pendingNoteNumber = event.noteNumber;
+                pendingVelocity = event.velocity;
+            }
+            else{
+                beginNote(event.noteNumber, event.velocity);
+            }
+            break;
+            
+        case Event::release:
+            // Whatever was waiting for the fade to finish isn't wanted any more
+            hasPendingNote = false;
+            
+            if(stealFadeRemaining == 0){
+                adsr.noteOff();
+                modAdsr.noteOff();
+            }
+            break;
+            
+        case Event::kill:
+            hasPendingNote = false;
+            
+            // Stopping dead in the middle of a waveform clicks, so an audible note (or filter tail) gets a short fade instead.
+            // renderSegment starts the note that stole the voice (if any) at the end of the fade
+            if(stealFadeRemaining == 0){
+                if(isPrepared && isSounding()){
+                    stealFadeRemaining = stealFadeLength;
+                }
+                else{
+                    adsr.reset();
+                    modAdsr.reset();
+                    ringOutLevel = 0.0f;
+                }
+            }
+            break;
+    }
 }
 
 void SynthVoice::pitchWheelMoved (int newPitchWheelValue){
@@ -35,28 +109,55 @@ void SynthVoice::controllerMoved (int controllerNumber, int newControllerValue){
 
 }
 
-void SynthVoice::prepareToPlay(double sampleRate, int samplesPerBlock, int outputChannels){
+void SynthVoice::prepareToPlay(double sampleRate, int samplesPerBlock){
     // the ProcessSpec structure is passed into a DSP algorithm's prepare() method, and contains information about various aspects of the context in which it can expect to be called.
     juce::dsp::ProcessSpec spec;
     spec.maximumBlockSize = samplesPerBlock;
     spec.sampleRate = sampleRate;
-    spec.numChannels = outputChannels;
+    // The voice itself is mono, it only gets spread across the output channels when it's mixed in
+    spec.numChannels = 1;
     
     // Then we pass this ProcessSpec object into the oscillator and gain
     // This prepareToPlay on osc is wrapped with our own OscData class
     osc.prepareToPlay(spec);
-    filter.prepareToPlay(sampleRate, samplesPerBlock, outputChannels);
-    modAdsr.setSampleRate (sampleRate);
+    filter.prepareToPlay(sampleRate, samplesPerBlock);
+    modulationBuffer.assign((size_t) juce::jmax(1, samplesPerBlock), 0.0f);
+    envelopeBuffer.assign(modulationBuffer.size(), 0.0f);
+    synthBuffer.setSize(1, juce::jmax(1, samplesPerBlock));
     gain.prepare(spec);
     
     // Apply new gain linearly rather than logarithmically
     gain.setGainLinear(0.3f);
     
-    adsr.setSampleRate(sampleRate);
+    setSampleRate(sampleRate);
     
     isPrepared = true;
 }
 
+void SynthVoice::reset() noexcept{
+    numQueuedEvents = 0;
+    hasPendingNote = false;
+    stealFadeRemaining = 0;
+    adsr.reset();
+    osc.reset();
+    goToSleep();
+}
+
+void SynthVoice::setSampleRate(double sampleRate) noexcept{
+    osc.setSampleRate(sampleRate);
+    filter.setSampleRate(sampleRate);
+    adsr.setSampleRate(sampleRate);
+    modAdsr.setSampleRate(sampleRate);
+    
+    // A fade that's under way keeps going from where it is, it only gets its length in samples from the new rate
+    const auto newFadeLength = juce::jmax(1, juce::roundToInt(sampleRate * stealFadeSeconds));
+    
+    if(stealFadeRemaining > 0)
+        stealFadeRemaining = juce::jmax(1, (int) ((juce::int64) stealFadeRemaining * newFadeLength / stealFadeLength));
+    
+    stealFadeLength = newFadeLength;
+}
+
 // This update function will be called by the processBlock to update information about the ADSR
 void SynthVoice::updateAdsr(const float attack, const float decay, const float sustain, const float release)
 {
@@ -69,48 +170,166 @@ void SynthVoice::renderNextBlock (juce::AudioBuffer<float> &outputBuffer, int st
     jassert(isPrepared);
     
     // If the voice is currently silent, it should just return without doing anything.
-    if(! isVoiceActive()) return;
+    if(! isVoiceActive()){
+        numQueuedEvents = 0;
+        return;
+    }
+    
+    // Render up to each queued event, apply it, and carry on from there
+    int position = 0;
+    
+    for(int i = 0; i < numQueuedEvents; ++i){
+        const auto& event = queuedEvents[(size_t) i];
+        const auto offset = juce::jlimit(position, numSamples, event.offset);
+        
+        renderSegment(outputBuffer, startSample + position, offset - position);
+        applyEvent(event);
+        position = offset;
+    }
+    
+    numQueuedEvents = 0;
+    renderSegment(outputBuffer, startSample + position, numSamples - position);
+    
+    endBlock();
+}
+
+void SynthVoice::renderSegment (juce::AudioBuffer<float> &outputBuffer, int startSample, int numSamples){
+    while(numSamples > 0 && isSounding()){
+        if(stealFadeRemaining == 0){
+            render(outputBuffer, startSample, numSamples);
+            return;
+        }
+        
+        const auto numFadeSamples = juce::jmin(numSamples, stealFadeRemaining);
+        render(outputBuffer, startSample, numFadeSamples);
+        startSample += numFadeSamples;
+        numSamples -= numFadeSamples;
+        
+        if(stealFadeRemaining == 0){
+            // The old note has faded out completely, so the next one starts from scratch
+            adsr.reset();
+            modAdsr.reset();
+            filter.reset();
+            ringOutLevel = 0.0f;
+            
+            if(hasPendingNote){
+                hasPendingNote = false;
+                beginNote(pendingNoteNumber, pendingVelocity);
+            }
+        }
+    }
+}
+
+void SynthVoice::render (juce::AudioBuffer<float> &outputBuffer, int startSample, int numSamples){
+    beginBlock(numSamples);
     
     // Instead of inputting new sounds into the outputBuffer, we put them in this synthBuffer first
-    synthBuffer.setSize(outputBuffer.getNumChannels(), numSamples, false, false, true);
-    // Notice how we apply the filter modAdsr here, when the synthbuffer is empty
-    modAdsr.applyEnvelopeToBuffer(synthBuffer, 0, numSamples);
-    synthBuffer.clear();
+    // It was sized for the largest block in prepareToPlay, so we only use the start of it here and never resize it on the audio thread.
+    // There's no need to clear it either, the oscillator overwrites every sample we use
+    jassert(numSamples <= synthBuffer.getNumSamples());
     
     // We put the processing of processBlock into renderNextBlock (processBlock is going to call renderNextBlock)
-    // the AudioBlock is essentially an alias for an audio buffer to put into dsp
-    // It is a Minimal and lightweight data-structure which contains a list of pointers to channels containing some kind of sample data.
-    // The object here is initialized with uniform initialization
-    juce::dsp::AudioBlock<float> audioBlock { synthBuffer };
-    // the ProcessContextReplacing object Contains context information that is passed into an algorithm's process method
-    osc.getNextAudioBlock(audioBlock);
-    
-    // Apply adsr
-    // Note that we apply adsr to outputBuffer while the process methods process on the audioBlock. This is ok because note that audioBlock is just an alias of outputBuffer
-    adsr.applyEnvelopeToBuffer(synthBuffer, 0, synthBuffer.getNumSamples());
+    auto* samples = synthBuffer.getWritePointer(0);
+    const auto isRingingOut = ! adsr.isActive();
     
-    // Process with the filter
-    filter.process(synthBuffer);
+    if(isRingingOut){
+        // The envelope has finished, so all that's left is the filter's tail and the oscillator has nothing to add
+        juce::FloatVectorOperations::clear(samples, numSamples);
+    }
+    else{
+        // The FM modulator works out the carrier's phase increments, then the oscillator reads its table with them
+        OscData::BlockSetup setup {};
+        
+        {
+            TAPSYNTH_PROFILE_STAGE(stageTimes, fmModulator);
+            setup = osc.beginBlock(numSamples);
+        }
+        {
+            TAPSYNTH_PROFILE_STAGE(stageTimes, oscillator);
+            osc.render(setup, samples, numSamples);
+        }
+        
+        // Apply adsr, which renders the whole block's gain at once
+        TAPSYNTH_PROFILE_STAGE(stageTimes, ampEnvelope);
+        adsr.process(envelopeBuffer.data(), numSamples);
+        juce::FloatVectorOperations::multiply(samples, envelopeBuffer.data(), numSamples);
+    }
     
-    // Process with the gain
-    gain.process(juce::dsp::ProcessContextReplacing<float>(audioBlock));
+    {
+        // Process with the filter
+        TAPSYNTH_PROFILE_STAGE(stageTimes, filter);
+        filter.process(samples, numSamples);
+        
+        // Only the tail is measured, a note that's still playing counts as audible however quiet it is (see beginBlock)
+        if(isRingingOut){
+            const auto range = juce::FloatVectorOperations::findMinAndMax(samples, numSamples);
+            ringOutLevel = juce::jmax(-range.getStart(), range.getEnd());
+        }
+    }
     
+    // A note that's being cut off ramps down linearly to silence over stealFadeLength samples
+    if(stealFadeRemaining > 0){
+        TAPSYNTH_PROFILE_STAGE(stageTimes, gain);
+        const auto fadeStart = (float) stealFadeRemaining / (float) stealFadeLength;
+        stealFadeRemaining -= numSamples;
+        const auto fadeEnd = (float) stealFadeRemaining / (float) stealFadeLength;
+        synthBuffer.applyGainRamp(0, 0, numSamples, fadeStart, fadeEnd);
+    }
     
+    // Now we add the mono synthBuffer into every channel of the outputBuffer, with the gain and pan applied on the way
+    TAPSYNTH_PROFILE_STAGE(stageTimes, mixToOutput);
     
+    if(outputBuffer.getNumChannels() == 1){
+        outputBuffer.addFrom(0, startSample, synthBuffer, 0, 0, numSamples, getGainLinear());
+    }
+    else{
+        outputBuffer.addFrom(0, startSample, synthBuffer, 0, 0, numSamples, getGainLinear() * leftGain);
+        outputBuffer.addFrom(1, startSample, synthBuffer, 0, 0, numSamples, getGainLinear() * rightGain);
+    }
+}
+
+void SynthVoice::beginBlock (int numSamples, FilterData::CoefficientCache* filterCache){
+    jassert(numSamples <= (int) modulationBuffer.size());
     
-    // Now we add the synthBuffer into the outputBuffer channel by channel
-    for(int channel = 0; channel < outputBuffer.getNumChannels(); ++channel){
-        outputBuffer.addFrom(channel, startSample, synthBuffer, channel, 0, numSamples);
-        
-        // If the sound that the voice is playing finishes during the course of this rendered block, it must call clearCurrentNote(), to tell the synthesiser that it has finished.
-        if(!adsr.isActive()) clearCurrentNote();
+    // Render the mod envelope as a control signal and let the filter follow it through the block.
+    // Only voices that are actually playing pay for this
+    {
+        TAPSYNTH_PROFILE_STAGE(stageTimes, modEnvelope);
+        modAdsr.process(modulationBuffer.data(), numSamples);
     }
+    
+    // Until the envelope has finished there's no tail to measure. If it finishes during this block, the voice stays awake
+    // for at least one more so the filter's ring-out gets measured
+    if(adsr.isActive())
+        ringOutLevel = 1.0f;
+    
+    TAPSYNTH_PROFILE_STAGE(stageTimes, filter);
+    filter.beginBlock(modulationBuffer.data(), numSamples, filterCache);
+}
+
+void SynthVoice::endBlock(){
+    // The exponential release spends its last stretch far below anything audible, so it's cut short there.
+    // The filter can still ring out after that, and renderNextBlock keeps the voice awake until it's quiet too
+    if(adsr.isReleasing() && adsr.getLevel() < silenceThreshold)
+        adsr.reset();
+    
+    // If the sound that the voice is playing finishes during the course of this rendered block, it must call clearCurrentNote(), to tell the synthesiser that it has finished.
+    // A fading voice is kept, it may still have a note to start once the fade is done
+    if(! isSounding()) goToSleep();
+}
+
+void SynthVoice::goToSleep() noexcept{
+    // What's left in the filter is below the threshold, so the next note may as well start from silence
+    filter.reset();
+    modAdsr.reset();
+    ringOutLevel = 0.0f;
+    clearCurrentNote();
 }
 
-void SynthVoice::updateFilter(const int filterType, const float frequency, const float resonance)
+// Only called when the filter parameters change, the mod envelope is applied on top of them in beginBlock
+void SynthVoice::updateFilter(const int type, const float frequency, const float resonance)
 {
-    float modulator = modAdsr.getNextSample();
-    filter.updateParameters(filterType, frequency, resonance, modulator);
+    filter.updateParameters(type, frequency, resonance);
 }
 
 void SynthVoice::updateModAdsr(const float attack, const float decay, const float sustain, const float release)
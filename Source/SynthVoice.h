@@ -15,10 +15,12 @@
 #include "OscData.h"
 #include "AdsrData.h"
 #include "FilterData.h"
+#include "StageProfiler.h"
 
 
 // SynthVoice represents a voice that a Synthesiser can use to play a SynthesiserSound. A voice plays a single sound at a time, and a synthesiser holds an array of voices so that it can play polyphonically.
-class SynthVoice : public juce::SynthesiserVoice
+// Voices live side by side in a VoicePool, so each one is aligned to a 64 byte cache line to keep neighbouring voices from sharing lines.
+class alignas (64) SynthVoice final : public juce::SynthesiserVoice
 {
 public:
     bool canPlaySound (juce::SynthesiserSound* sound) override;
@@ -26,16 +28,75 @@ public:
     void stopNote (float velocity, bool allowTailOff) override;
     void pitchWheelMoved (int newPitchWheelValue) override;
     void controllerMoved (int controllerNumber, int newControllerValue) override;
-    void prepareToPlay (double sampleRate, int samplesPerBlock, int outputChannels);
+    void prepareToPlay (double sampleRate, int samplesPerBlock);
+    
+    // Stops the voice on the spot, without a fade, and drops any events it hasn't applied yet.
+    // Afterwards it plays its next note exactly as a freshly prepared voice would
+    void reset() noexcept;
+    
+    // Changes the rate the voice renders at without allocating, and without cutting off the note it's playing.
+    // The engine uses this to switch oversampling, the voice has to have been prepared for the longer blocks already
+    void setSampleRate (double sampleRate) noexcept;
     void renderNextBlock (juce::AudioBuffer<float> &outputBuffer, int startSample, int numSamples) override;
     
     void updateAdsr(const float attack, const float decay, const float sustain, const float release);
     void updateFilter(const int filterType, const float frequency, const float resonance);
     void updateModAdsr(const float attack, const float decay, const float sustain, const float release);
     
+    // How far notes are panned away from the centre by pitch, from 0 (every note centred) to 1. Picked up by the next note
+    void setPanSpread(const float spread) noexcept { panSpread = spread; }
+    
     OscData& getOscillator() { return osc; };
     
+    // Events are applied at their exact sample inside renderNextBlock. SynthEngine points this at the offset, within the chunk
+    // it's about to render, of the MIDI event it's handling. Without a source every event lands at the start of the next render
+    void setEventOffsetSource(const int* offset) noexcept { eventOffsetSource = offset; }
+    
+    // A voice with events waiting, fading out a stolen (or killed) note, or ringing out after its envelope has finished,
+    // has to go through renderNextBlock rather than a VoiceBatchRenderer group
+    bool canRenderInGroup() const noexcept { return numQueuedEvents == 0 && stealFadeRemaining == 0 && adsr.isActive(); }
+    
+    // The current level of the amp envelope, which the quietest voice stealing policy compares
+    float getLevel() const noexcept { return adsr.getLevel(); }
+    
+    // renderNextBlock is split into these steps so the VoiceBatchRenderer can run the DSP of several voices side by side in SIMD lanes.
+    // beginBlock does the per-block control work (mod envelope, filter coefficients), endBlock puts the voice to sleep once it's silent.
+    // Voices that are rendered together can share a cache for their filter coefficients
+    void beginBlock (int numSamples, FilterData::CoefficientCache* filterCache = nullptr);
+    void endBlock();
+    
+    AdsrData& getAmpEnvelope() noexcept { return adsr; }
+    FilterData& getFilter() noexcept { return filter; }
+    float getGainLinear() const noexcept { return gain.getGainLinear(); }
+    
+    // The current note's pan, as gains for the left and right output channels
+    float getLeftGain() const noexcept { return leftGain; }
+    float getRightGain() const noexcept { return rightGain; }
+    
+   #if TAPSYNTH_PROFILING
+    // Where the voice's time went since the engine last collected it
+    StageTimes& getStageTimes() noexcept { return stageTimes; }
+   #endif
+    
 private:
+    struct Event
+    {
+        enum Type : juce::uint8 { start, release, kill };
+        
+        Type type;
+        int offset;
+        int noteNumber;
+        float velocity;
+    };
+    
+    void queueEvent (Event event);
+    void applyEvent (const Event& event);
+    void beginNote (int midiNoteNumber, float velocity);
+    
+    bool isSounding() const noexcept { return stealFadeRemaining > 0 || adsr.isActive() || ringOutLevel >= silenceThreshold; }
+    void goToSleep() noexcept;
+    void renderSegment (juce::AudioBuffer<float> &outputBuffer, int startSample, int numSamples);
+    void render (juce::AudioBuffer<float> &outputBuffer, int startSample, int numSamples);
     
     OscData osc;
     AdsrData adsr;
@@ -45,10 +106,43 @@ private:
     juce::dsp::Gain<float> gain;
     bool isPrepared {false};
     
+    float panSpread {0.0f};
+    float leftGain {1.0f};
+    float rightGain {1.0f};
+    
+    // Notes that are cut off (mostly because their voice was stolen) fade out over a few milliseconds instead of stopping dead.
+    // A note that is started on the voice meanwhile waits until the fade is done
+    static constexpr double stealFadeSeconds = 0.003;
+    int stealFadeLength {1};
+    int stealFadeRemaining {0};
+    bool hasPendingNote {false};
+    int pendingNoteNumber {0};
+    float pendingVelocity {0.0f};
+    
+    // A voice stays awake after its envelope finishes while the filter rings out (a resonant filter can for a while),
+    // and goes to sleep once the peak of a block falls below -80 dB. The last, inaudible stretch of a release is skipped the same way
+    static constexpr float silenceThreshold = 1.0e-4f;
+    float ringOutLevel {0.0f};
+    
+    // startNote and stopNote only queue their event. renderNextBlock applies them in order at their offsets
+    static constexpr int maxQueuedEvents = 8;
+    std::array<Event, (size_t) maxQueuedEvents> queuedEvents {};
+    int numQueuedEvents {0};
+    const int* eventOffsetSource {nullptr};
+    
+    // The mod envelope rendered as a control signal for the filter cutoff, one value per sample of the block
+    std::vector<float> modulationBuffer;
+    
+    // The amp envelope's gain for every sample of the block
+    std::vector<float> envelopeBuffer;
+    
     // Create an additional buffer to remove clicking when playing different notes
     // When we input an outputBuffer into renderNextBlock, there may already be samples in the outputBuffer.
     // When we  press a new note and render the next block in the same outputBuffer, the phase of the sound already in the outputBuffer may clash with the new sound's phase, causing clicking
     // To solve this, we create this synthBuffer and apply chnges to it, AND THEN we add this synthBuffer to the outputBuffer
     juce::AudioBuffer<float> synthBuffer;
     
+   #if TAPSYNTH_PROFILING
+    StageTimes stageTimes;
+   #endif
 };
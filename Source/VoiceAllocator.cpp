@@ -0,0 +1,200 @@
+/*
+  ==============================================================================
+
+    VoiceAllocator.cpp
+    Created: 17 Oct 2026 6:48:33pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "VoiceAllocator.h"
+
+VoiceAllocator::VoiceAllocator (int numVoices)
+    : states ((size_t) numVoices, State::free),
+      freeVoices ((size_t) numVoices),
+      numFreeVoices (numVoices),
+      ageLinks ((size_t) numVoices),
+      releaseLinks ((size_t) numVoices),
+      noteLinks ((size_t) numVoices),
+      noteLists ((size_t) numNoteKeys),
+      noteKeys ((size_t) numVoices, -1),
+      startCounts ((size_t) numVoices, 0),
+      levels ((size_t) numVoices, 0.0f)
+{
+    // Handing out the lowest indices first keeps a few notes at the start of the pool
+    for (int i = 0; i < numVoices; ++i)
+        freeVoices[(size_t) i] = numVoices - 1 - i;
+
+    quietHeap.reserve ((size_t) numVoices);
+}
+
+//==============================================================================
+void VoiceAllocator::voiceStarted (int voice, int midiChannel, int midiNoteNumber) noexcept
+{
+    // A stolen voice leaves the lists of its old note first. Free voices have been taken off the free stack already
+    if (states[(size_t) voice] != State::free)
+        unlink (voice);
+
+    states[(size_t) voice] = State::held;
+    ++startCounts[(size_t) voice];
+    append (ageList, ageLinks, voice);
+
+    const auto key = getNoteKey (midiChannel, midiNoteNumber);
+    noteKeys[(size_t) voice] = key;
+
+    // Newest first, so a retrigger finds the latest voice of the note straight away
+    auto& noteList = noteLists[(size_t) key];
+    noteLinks[(size_t) voice] = { noVoice, noteList.head };
+
+    if (noteList.head != noVoice)
+        noteLinks[(size_t) noteList.head].previous = voice;
+    else
+        noteList.tail = voice;
+
+    noteList.head = voice;
+}
+
+void VoiceAllocator::voiceReleased (int voice) noexcept
+{
+    if (states[(size_t) voice] != State::held)
+        return;
+
+    states[(size_t) voice] = State::released;
+    append (releaseList, releaseLinks, voice);
+}
+
+void VoiceAllocator::voiceFreed (int voice) noexcept
+{
+    if (states[(size_t) voice] == State::free)
+        return;
+
+    unlink (voice);
+    states[(size_t) voice] = State::free;
+    freeVoices[(size_t) numFreeVoices++] = voice;
+}
+
+int VoiceAllocator::getFirstVoiceForNote (int midiChannel, int midiNoteNumber) const noexcept
+{
+    return noteLists[(size_t) getNoteKey (midiChannel, midiNoteNumber)].head;
+}
+
+//==============================================================================
+int VoiceAllocator::takeFreeVoice() noexcept
+{
+    return numFreeVoices > 0 ? freeVoices[(size_t) --numFreeVoices] : noVoice;
+}
+
+int VoiceAllocator::findVoiceToSteal (StealPolicy policy, int midiChannel, int midiNoteNumber) noexcept
+{
+    jassert (numFreeVoices == 0);
+
+    switch (policy)
+    {
+        case StealPolicy::quietest:
+        {
+            if (quietHeapIsStale)
+                updateQuietestVoices();
+
+            // Entries go stale when their voice is freed or restarted after the heap was built. Those are simply skipped,
+            // and a flood of notes that uses up the heap falls back to the oldest voice until the next block's levels refill it
+            while (! quietHeap.empty())
+            {
+                std::pop_heap (quietHeap.begin(), quietHeap.end(), isLouder);
+                const auto entry = quietHeap.back();
+                quietHeap.pop_back();
+
+                if (states[(size_t) entry.voice] != State::free && startCounts[(size_t) entry.voice] == entry.startCount)
+                    return entry.voice;
+            }
+
+            break;
+        }
+
+        case StealPolicy::sameNote:
+        {
+            const auto voice = getFirstVoiceForNote (midiChannel, midiNoteNumber);
+
+            if (voice != noVoice)
+                return voice;
+
+            break;
+        }
+
+        case StealPolicy::releasedFirst:
+        {
+            if (releaseList.head != noVoice)
+                return releaseList.head;
+
+            break;
+        }
+
+        case StealPolicy::oldest:
+        default:
+            break;
+    }
+
+    return ageList.head;
+}
+
+void VoiceAllocator::updateQuietestVoices() noexcept
+{
+    quietHeap.clear();
+
+    for (auto voice = ageList.head; voice != noVoice; voice = ageLinks[(size_t) voice].next)
+        quietHeap.push_back ({ levels[(size_t) voice], voice, startCounts[(size_t) voice] });
+
+    std::make_heap (quietHeap.begin(), quietHeap.end(), isLouder);
+    quietHeapIsStale = false;
+}
+
+//==============================================================================
+void VoiceAllocator::unlink (int voice) noexcept
+{
+    if (states[(size_t) voice] == State::released)
+        remove (releaseList, releaseLinks, voice);
+
+    remove (ageList, ageLinks, voice);
+    remove (noteLists[(size_t) noteKeys[(size_t) voice]], noteLinks, voice);
+    noteKeys[(size_t) voice] = -1;
+}
+
+void VoiceAllocator::append (List& list, std::vector<Links>& links, int voice) noexcept
+{
+    links[(size_t) voice] = { list.tail, noVoice };
+
+    if (list.tail != noVoice)
+        links[(size_t) list.tail].next = voice;
+    else
+        list.head = voice;
+
+    list.tail = voice;
+}
+
+void VoiceAllocator::remove (List& list, std::vector<Links>& links, int voice) noexcept
+{
+    auto& link = links[(size_t) voice];
+
+    if (link.previous != noVoice)
+        links[(size_t) link.previous].next = link.next;
+    else
+        list.head = link.next;
+
+    if (link.next != noVoice)
+        links[(size_t) link.next].previous = link.previous;
+    else
+        list.tail = link.previous;
+
+    link = {};
+}
+
+bool VoiceAllocator::isLouder (const QuietEntry& a, const QuietEntry& b) noexcept
+{
+    // Makes std::make_heap put the quietest entry at the front
+    return a.level > b.level;
+}
+
+int VoiceAllocator::getNoteKey (int midiChannel, int midiNoteNumber) noexcept
+{
+    return (juce::jlimit (1, 16, midiChannel) - 1) * 128 + juce::jlimit (0, 127, midiNoteNumber);
+}
@@ -0,0 +1,112 @@
+/*
+  ==============================================================================
+
+    VoiceAllocator.h
+    Created: 17 Oct 2026 6:48:33pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Keeps track of what every voice of the pool is doing, so that SynthEngine can answer "which voice plays this note"
+// without looking at every voice. Voices are referred to by their index in the VoicePool.
+//
+// Free voices sit on a stack. Busy voices are linked into a list in the order they started, released voices into a second list
+// in the order they were released, and every busy voice into a list for its MIDI channel and note. Keeping these up to date
+// is O(1) per event, as are most of the steal policies. The quietest voice comes from a heap of envelope levels
+// that is rebuilt once per rendered block, rather than from a search on every note.
+class VoiceAllocator
+{
+public:
+    enum class StealPolicy
+    {
+        oldest,             // the voice that started first
+        quietest,           // the voice with the lowest amp envelope level at the end of the last block
+        sameNote,           // a note that is already sounding is retriggered on its own voice, otherwise the oldest voice is stolen
+        releasedFirst       // the voice that was released first, or the oldest if every voice is still held
+    };
+
+    static constexpr int noVoice = -1;
+
+    explicit VoiceAllocator (int numVoices);
+
+    int size() const noexcept { return (int) states.size(); }
+
+    //==============================================================================
+    // Bookkeeping. voiceStarted also covers a busy voice that is restarted with a new note
+    void voiceStarted (int voice, int midiChannel, int midiNoteNumber) noexcept;
+    void voiceReleased (int voice) noexcept;
+    void voiceFreed (int voice) noexcept;
+
+    bool isFree (int voice) const noexcept        { return states[(size_t) voice] == State::free; }
+    bool isReleased (int voice) const noexcept    { return states[(size_t) voice] == State::released; }
+    int getNumBusyVoices() const noexcept         { return size() - numFreeVoices; }
+
+    // The voices playing a note, newest first. Iterate with getNextVoiceForNote until it returns noVoice
+    int getFirstVoiceForNote (int midiChannel, int midiNoteNumber) const noexcept;
+    int getNextVoiceForNote (int voice) const noexcept    { return noteLinks[(size_t) voice].next; }
+
+    //==============================================================================
+    // Takes a voice off the free stack, or returns noVoice if they're all busy
+    int takeFreeVoice() noexcept;
+
+    // Picks the busy voice to give to a new note. Only call it when there are no free voices
+    int findVoiceToSteal (StealPolicy policy, int midiChannel, int midiNoteNumber) noexcept;
+
+    // Gives the allocator the amp envelope level of a busy voice. Call it for every busy voice after each rendered block.
+    // The levels are only sorted once the quietest policy next has to steal a voice, so other policies don't pay for them
+    void setLevel (int voice, float level) noexcept     { levels[(size_t) voice] = level; quietHeapIsStale = true; }
+
+private:
+    enum class State : juce::uint8 { free, held, released };
+
+    struct Links
+    {
+        int previous { noVoice };
+        int next { noVoice };
+    };
+
+    struct List
+    {
+        int head { noVoice };
+        int tail { noVoice };
+    };
+
+    struct QuietEntry
+    {
+        float level;
+        int voice;
+        juce::uint32 startCount;
+    };
+
+    void updateQuietestVoices() noexcept;
+    void unlink (int voice) noexcept;
+    static void append (List& list, std::vector<Links>& links, int voice) noexcept;
+    static void remove (List& list, std::vector<Links>& links, int voice) noexcept;
+
+    static bool isLouder (const QuietEntry& a, const QuietEntry& b) noexcept;
+
+    static constexpr int numNoteKeys = 16 * 128;
+    static int getNoteKey (int midiChannel, int midiNoteNumber) noexcept;
+
+    std::vector<State> states;
+    std::vector<int> freeVoices;
+    int numFreeVoices { 0 };
+
+    List ageList, releaseList;
+    std::vector<Links> ageLinks, releaseLinks, noteLinks;
+    std::vector<List> noteLists;
+    std::vector<int> noteKeys;
+
+    // Counts the notes each voice has started, so entries for a voice that has moved on to another note can be told apart
+    std::vector<juce::uint32> startCounts;
+    std::vector<float> levels;
+    std::vector<QuietEntry> quietHeap;
+    bool quietHeapIsStale { false };
+
+    JUCE_DECLARE_NON_COPYABLE (VoiceAllocator)
+};
@@ -0,0 +1,186 @@
+/*
+  ==============================================================================
+
+    VoiceBatchRenderer.cpp
+    Created: 17 Oct 2026 4:27:15pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "VoiceBatchRenderer.h"
+
+void VoiceBatchRenderer::prepare (int maximumBlockSize)
+{
+    maxBlockSize = juce::jmax (1, maximumBlockSize);
+
+   #if JUCE_USE_SIMD
+    incrementLanes.allocate (maxBlockSize);
+    phaseLanes.allocate (maxBlockSize);
+    voiceLanes.allocate (maxBlockSize);
+
+    for (auto& lanes : outputLanes)
+        lanes.allocate (maxBlockSize);
+
+    envelopeValues.assign ((size_t) maxBlockSize, 0.0f);
+    filterBank.prepare (maxBlockSize);
+   #endif
+}
+
+void VoiceBatchRenderer::render (SynthVoice* const* voices, int numVoices, juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    int index = 0;
+
+   #if JUCE_USE_SIMD
+    jassert (numSamples <= maxBlockSize);
+
+    for (; index + numLanes <= numVoices; index += numLanes)
+        renderGroup (voices + index, outputAudio, startSample, numSamples);
+   #endif
+
+    for (; index < numVoices; ++index)
+        voices[index]->renderNextBlock (outputAudio, startSample, numSamples);
+}
+
+#if JUCE_USE_SIMD
+void VoiceBatchRenderer::renderGroup (SynthVoice* const* group, juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    OscData::BlockSetup setups[numLanes];
+    auto phase = Register::expand (0.0f);
+
+   #if TAPSYNTH_PROFILING
+    StageTimes* groupTimes[numLanes];
+
+    for (int lane = 0; lane < numLanes; ++lane)
+        groupTimes[lane] = &group[lane]->getStageTimes();
+   #endif
+
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto& voice = *group[lane];
+        voice.beginBlock (numSamples, &filterBank.getCoefficientCache());
+
+        TAPSYNTH_PROFILE_STAGE (voice.getStageTimes(), fmModulator);
+        auto& osc = voice.getOscillator();
+        setups[lane] = osc.beginBlock (numSamples);
+        phase.set ((size_t) lane, osc.getPhase());
+
+        for (int i = 0; i < numSamples; ++i)
+            incrementLanes.getSample (i)[lane] = setups[lane].increments[i];
+    }
+
+    // Oscillators: every lane's phase moves at once, and each sample's phases are kept for the table reads below.
+    // With FM the increment can be negative, so the phase wraps in both directions
+    const auto zero = Register::expand (0.0f);
+    const auto one = Register::expand (1.0f);
+
+    {
+        TAPSYNTH_PROFILE_GROUP_STAGE (groupTimes, numLanes, oscillator);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            phaseLanes.store (i, phase);
+
+            // Wrapping a phase just below zero can round up to exactly one, so the upward wrap comes first
+            phase += incrementLanes.load (i);
+            phase += one & Register::lessThan (phase, zero);
+            phase -= one & Register::greaterThanOrEqual (phase, one);
+        }
+
+        for (int lane = 0; lane < numLanes; ++lane)
+            group[lane]->getOscillator().setPhase (phase.get ((size_t) lane));
+    }
+
+    // Every lane reads its own tables, so this goes a column at a time, with the lane's envelope applied on the way
+    for (int lane = 0; lane < numLanes; ++lane)
+    {
+        auto& voice = *group[lane];
+
+        {
+            TAPSYNTH_PROFILE_STAGE (voice.getStageTimes(), ampEnvelope);
+            voice.getAmpEnvelope().process (envelopeValues.data(), numSamples);
+        }
+
+        TAPSYNTH_PROFILE_STAGE (voice.getStageTimes(), oscillator);
+        const auto& setup = setups[lane];
+        const auto* envelope = envelopeValues.data();
+
+        if (! setup.isBlending())
+        {
+            for (int i = 0; i < numSamples; ++i)
+                voiceLanes.getSample (i)[lane] = WavetableBank::read (setup.table, phaseLanes.getSample (i)[lane]) * envelope[i];
+        }
+        else
+        {
+            // Near a mip level boundary the next level up is blended in, as in OscData::render
+            auto mix = setup.mix;
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto lanePhase = phaseLanes.getSample (i)[lane];
+                const auto lower = WavetableBank::read (setup.table, lanePhase);
+                voiceLanes.getSample (i)[lane] = (lower + mix * (WavetableBank::read (setup.nextTable, lanePhase) - lower)) * envelope[i];
+                mix += setup.mixIncrement;
+            }
+        }
+    }
+
+    // Filters, then each voice is spread to the output channels with its gain and pan
+    FilterData* filters[numLanes];
+    auto leftGain = zero, rightGain = zero;
+    const auto numChannels = juce::jmin (outputAudio.getNumChannels(), 2);
+
+    {
+        TAPSYNTH_PROFILE_GROUP_STAGE (groupTimes, numLanes, gain);
+
+        for (int lane = 0; lane < numLanes; ++lane)
+        {
+            auto& voice = *group[lane];
+            filters[lane] = &voice.getFilter();
+
+            // A mono output gets every voice at its centre level
+            leftGain.set ((size_t) lane, voice.getGainLinear() * (numChannels > 1 ? voice.getLeftGain() : 1.0f));
+            rightGain.set ((size_t) lane, voice.getGainLinear() * voice.getRightGain());
+        }
+    }
+
+    {
+        TAPSYNTH_PROFILE_GROUP_STAGE (groupTimes, numLanes, filter);
+        filterBank.process (filters, voiceLanes, numSamples);
+    }
+
+    {
+        TAPSYNTH_PROFILE_GROUP_STAGE (groupTimes, numLanes, mixToOutput);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto y = voiceLanes.load (i);
+            outputLanes[0].store (i, y * leftGain);
+
+            if (numChannels > 1)
+                outputLanes[1].store (i, y * rightGain);
+        }
+
+        // The one reduction across the lanes, in lane order, so the sum doesn't depend on the instruction set
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            auto* output = outputAudio.getWritePointer (channel, startSample);
+            const auto& lanes = outputLanes[(size_t) channel];
+
+            for (int i = 0; i < numSamples; ++i)
+            {
+                const auto* sample = lanes.getSample (i);
+                auto sum = sample[0];
+
+                for (int lane = 1; lane < numLanes; ++lane)
+                    sum += sample[lane];
+
+                output[i] += sum;
+            }
+        }
+    }
+
+    for (int lane = 0; lane < numLanes; ++lane)
+        group[lane]->endBlock();
+}
+#endif
@@ -0,0 +1,49 @@
+/*
+  ==============================================================================
+
+    VoiceBatchRenderer.h
+    Created: 17 Oct 2026 4:27:15pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SynthVoice.h"
+#include "FilterBank.h"
+
+// Renders the playing voices in groups, one voice per lane of a juce::dsp::SIMDRegister<float> (4 lanes with SSE and NEON).
+// The phase accumulators and (through a FilterBank) the filters of a group run together in mono, on structure-of-arrays
+// lane buffers that each voice fills or reads a column of. The group is panned into a column per channel with whole registers,
+// and the lanes are summed into the output once, at the end of the group's block. Voices that don't fill a whole group
+// go through SynthVoice::renderNextBlock.
+class VoiceBatchRenderer
+{
+public:
+   #if JUCE_USE_SIMD
+    using Register = juce::dsp::SIMDRegister<float>;
+    static constexpr int numLanes = (int) Register::SIMDNumElements;
+   #else
+    static constexpr int numLanes = 1;
+   #endif
+
+    // Sizes the lane buffers. render must never be given more samples than this
+    void prepare (int maximumBlockSize);
+
+    void render (SynthVoice* const* voices, int numVoices, juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples);
+
+private:
+   #if JUCE_USE_SIMD
+    void renderGroup (SynthVoice* const* group, juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples);
+
+    // Lane i of every buffer belongs to the group's i-th voice
+    FilterBank::LaneBuffer incrementLanes, phaseLanes, voiceLanes;
+    std::array<FilterBank::LaneBuffer, 2> outputLanes;
+    std::vector<float> envelopeValues;
+    FilterBank filterBank;
+   #endif
+
+    int maxBlockSize { 0 };
+};
@@ -0,0 +1,48 @@
+/*
+  ==============================================================================
+
+    VoicePool.h
+    Created: 17 Oct 2026 11:02:15am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "SynthVoice.h"
+
+// Owns every SynthVoice of the synth in one contiguous allocation.
+// SynthVoice is cache-line aligned, so each voice starts on its own line and iterating the pool walks memory linearly
+// instead of hopping between separately heap-allocated voices.
+class VoicePool
+{
+public:
+    static constexpr int maxVoices = 128;
+
+    explicit VoicePool (int numVoicesToAllocate)
+        : numVoices (juce::jlimit (1, maxVoices, numVoicesToAllocate)),
+          voices (std::make_unique<SynthVoice[]> ((size_t) numVoices))
+    {
+    }
+
+    int size() const noexcept { return numVoices; }
+
+    SynthVoice& operator[] (int index) noexcept
+    {
+        jassert (juce::isPositiveAndBelow (index, numVoices));
+        return voices[(size_t) index];
+    }
+
+    SynthVoice* begin() noexcept { return voices.get(); }
+    SynthVoice* end() noexcept { return voices.get() + numVoices; }
+    const SynthVoice* begin() const noexcept { return voices.get(); }
+    const SynthVoice* end() const noexcept { return voices.get() + numVoices; }
+
+private:
+    int numVoices;
+    std::unique_ptr<SynthVoice[]> voices;
+
+    JUCE_DECLARE_NON_COPYABLE (VoicePool)
+};
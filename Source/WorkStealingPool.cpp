@@ -0,0 +1,229 @@
+/*
+  ==============================================================================
+
+    WorkStealingPool.cpp
+    Created: 17 Oct 2026 7:15:36pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "WorkStealingPool.h"
+
+#include <thread>
+
+namespace
+{
+    // How many times an idle worker looks for work before it goes to sleep. Blocks arrive every few milliseconds,
+    // so workers stay awake through short gaps and a busy audio thread almost never has to wake anyone
+    constexpr int idleRoundsBeforeSleeping = 512;
+}
+
+//==============================================================================
+class WorkStealingPool::Worker : public juce::Thread
+{
+public:
+    Worker (WorkStealingPool& ownerPool, int workerParticipant)
+        : juce::Thread ("TapSynth voice worker"),
+          pool (ownerPool),
+          participant (workerParticipant)
+    {
+    }
+
+    void wake() noexcept    { wakeEvent.signal(); }
+
+    void run() override
+    {
+        int idleRounds = 0;
+
+        while (! threadShouldExit())
+        {
+            if (pool.runAvailableJobs (participant))
+            {
+                idleRounds = 0;
+                continue;
+            }
+
+            if (++idleRounds < idleRoundsBeforeSleeping)
+            {
+                std::this_thread::yield();
+                continue;
+            }
+
+            // Announce that we're going to sleep before the last look for work, so a batch that's published in between
+            // either gets seen here or sees us sleeping and wakes us. The timeout is only a safety net
+            pool.numSleepingWorkers.fetch_add (1);
+
+            if (! pool.hasRunningBatch())
+                wakeEvent.wait (100.0);
+
+            pool.numSleepingWorkers.fetch_sub (1);
+            idleRounds = 0;
+        }
+    }
+
+private:
+    WorkStealingPool& pool;
+    const int participant;
+    juce::WaitableEvent wakeEvent;
+};
+
+//==============================================================================
+WorkStealingPool::WorkStealingPool()
+    : numWorkers (juce::jlimit (0, maxWorkers, juce::SystemStats::getNumCpus() - 1))
+{
+}
+
+void WorkStealingPool::startWorkers()
+{
+    const juce::ScopedLock sl (startLock);
+
+    if (workersRunning.load() || numWorkers == 0)
+        return;
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        workers.push_back (std::make_unique<Worker> (*this, i + 1));
+
+        // The audio thread waits for whatever jobs the workers have claimed, so a worker that's preempted holds the block up.
+        // They get the same kind of priority as the audio thread, or the highest normal one where realtime threads are refused
+        if (! workers.back()->startRealtimeThread (juce::Thread::RealtimeOptions{}))
+            workers.back()->startThread (juce::Thread::Priority::highest);
+    }
+
+    // Publishing this makes the workers visible to run
+    workersRunning.store (true);
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+    for (auto& worker : workers)
+    {
+        worker->signalThreadShouldExit();
+        worker->wake();
+    }
+
+    for (auto& worker : workers)
+        worker->stopThread (2000);
+}
+
+void WorkStealingPool::run (JobFunction function, void* context, int numJobs) noexcept
+{
+    if (numJobs <= 0)
+        return;
+
+    // Claim a free batch slot
+    Batch* batch = nullptr;
+
+    if (numJobs > 1 && workersRunning.load())
+    {
+        for (auto& candidate : batches)
+        {
+            auto expected = (int) freeBatch;
+
+            if (candidate.state.compare_exchange_strong (expected, (int) preparingBatch))
+            {
+                batch = &candidate;
+                break;
+            }
+        }
+    }
+
+    if (batch == nullptr)
+    {
+        for (int job = 0; job < numJobs; ++job)
+            function (context, job, 0);
+
+        return;
+    }
+
+    batch->function = function;
+    batch->context = context;
+    batch->numJobs = numJobs;
+    batch->numCompleted.store (0);
+
+    const auto numParticipants = getNumParticipants();
+
+    for (int participant = 0; participant < numParticipants; ++participant)
+    {
+        auto& range = batch->ranges[(size_t) participant];
+        range.next.store (participant * numJobs / numParticipants);
+        range.end = (participant + 1) * numJobs / numParticipants;
+    }
+
+    // Publishing the batch makes everything written above visible to the workers that pick it up
+    batch->state.store (runningBatch);
+
+    if (numSleepingWorkers.load() > 0)
+        for (auto& worker : workers)
+            worker->wake();
+
+    runJobs (*batch, 0);
+
+    while (batch->numCompleted.load (std::memory_order_acquire) < numJobs)
+        std::this_thread::yield();
+
+    // Every job is done, but a worker may still be looking at the batch. Wait for it to leave before the slot can be reused
+    batch->state.store (finishingBatch);
+
+    while (batch->numParticipantsInside.load() > 0)
+        std::this_thread::yield();
+
+    batch->state.store (freeBatch);
+}
+
+bool WorkStealingPool::runAvailableJobs (int participant) noexcept
+{
+    auto ranAny = false;
+
+    for (auto& batch : batches)
+    {
+        if (batch.state.load (std::memory_order_relaxed) != runningBatch)
+            continue;
+
+        // Enter first and check again, so the batch can't be finished and handed to someone else while we're inside
+        batch.numParticipantsInside.fetch_add (1);
+
+        if (batch.state.load() == runningBatch)
+            ranAny = runJobs (batch, participant) || ranAny;
+
+        batch.numParticipantsInside.fetch_sub (1);
+    }
+
+    return ranAny;
+}
+
+bool WorkStealingPool::runJobs (Batch& batch, int participant) noexcept
+{
+    auto ranAny = false;
+    const auto numParticipants = getNumParticipants();
+
+    // Our own range first, then steal from everyone else's
+    for (int offset = 0; offset < numParticipants; ++offset)
+    {
+        auto& range = batch.ranges[(size_t) ((participant + offset) % numParticipants)];
+
+        while (range.next.load (std::memory_order_relaxed) < range.end)
+        {
+            const auto job = range.next.fetch_add (1, std::memory_order_acq_rel);
+
+            if (job >= range.end)
+                break;
+
+            batch.function (batch.context, job, participant);
+            batch.numCompleted.fetch_add (1, std::memory_order_release);
+            ranAny = true;
+        }
+    }
+
+    return ranAny;
+}
+
+bool WorkStealingPool::hasRunningBatch() const noexcept
+{
+    for (auto& batch : batches)
+        if (batch.state.load() == runningBatch)
+            return true;
+
+    return false;
+}
@@ -0,0 +1,94 @@
+/*
+  ==============================================================================
+
+    WorkStealingPool.h
+    Created: 17 Oct 2026 7:15:36pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// A pool of worker threads that helps an audio thread get through a batch of independent jobs.
+// Every plugin instance in the process shares one pool: hold it through a juce::SharedResourcePointer<WorkStealingPool>.
+//
+// Each batch's jobs are dealt out as contiguous ranges, one per participant (the calling thread plus every worker).
+// A participant takes jobs from the front of its own range and, once that's empty, steals from the front of the others.
+// Jobs are claimed with atomic increments, so nothing locks and nothing allocates while a batch runs.
+// The calling thread always works on its own batch too, so the batch finishes even if no worker gets to it.
+// The workers are only started once something asks for them with startWorkers. Until then every batch runs on the calling thread
+class WorkStealingPool
+{
+public:
+    // Called with the job's index and the index of the participant running it:
+    // 0 for the thread that called run, 1 and up for the workers
+    using JobFunction = void (*) (void* context, int jobIndex, int participant);
+
+    static constexpr int maxWorkers = 15;
+    static constexpr int maxConcurrentBatches = 16;
+
+    // Plans one worker for every core beyond the first, up to maxWorkers, but doesn't start them
+    WorkStealingPool();
+    ~WorkStealingPool();
+
+    // Starts the workers, if they aren't running yet. It creates threads, so call it from the message thread, never the audio thread
+    void startWorkers();
+    bool areWorkersRunning() const noexcept    { return workersRunning.load(); }
+
+    // These count the workers whether they're running or not, so they don't change once the pool exists
+    int getNumWorkers() const noexcept         { return numWorkers; }
+    int getNumParticipants() const noexcept    { return numWorkers + 1; }
+
+    // Runs every job and returns once they have all finished. Can be called from several threads at once (one batch each);
+    // if every batch slot is taken the jobs simply run on the calling thread.
+    // The only step that isn't lock-free is waking workers that went to sleep after a long time without work
+    void run (JobFunction function, void* context, int numJobs) noexcept;
+
+private:
+    class Worker;
+
+    struct alignas (64) JobRange
+    {
+        std::atomic<int> next { 0 };
+        int end { 0 };
+    };
+
+    enum BatchState
+    {
+        freeBatch = 0,
+        preparingBatch,
+        runningBatch,
+        finishingBatch
+    };
+
+    struct Batch
+    {
+        std::atomic<int> state { freeBatch };
+        std::atomic<int> numParticipantsInside { 0 };
+        std::atomic<int> numCompleted { 0 };
+
+        JobFunction function { nullptr };
+        void* context { nullptr };
+        int numJobs { 0 };
+
+        std::array<JobRange, maxWorkers + 1> ranges;
+    };
+
+    bool runAvailableJobs (int participant) noexcept;
+    bool runJobs (Batch& batch, int participant) noexcept;
+    bool hasRunningBatch() const noexcept;
+
+    int numWorkers { 0 };
+    std::array<Batch, maxConcurrentBatches> batches;
+    std::atomic<int> numSleepingWorkers { 0 };
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    // Set once every worker has started, and only then does run hand out jobs to them
+    std::atomic<bool> workersRunning { false };
+    juce::CriticalSection startLock;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (WorkStealingPool)
+};
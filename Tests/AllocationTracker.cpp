@@ -0,0 +1,156 @@
+/*
+  ==============================================================================
+
+    AllocationTracker.cpp
+    Created: 17 Oct 2026 6:02:48pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "AllocationTracker.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    // Plain atomics with constant initialisation, so the hooks below work before main and never allocate themselves
+    std::atomic<bool> isChecking { false };
+    std::atomic<int> numAllocations { 0 };
+    std::atomic<int> numFrees { 0 };
+    std::atomic<size_t> firstAllocationSize { 0 };
+
+    void recordAllocation (size_t size) noexcept
+    {
+        if (! isChecking.load (std::memory_order_relaxed))
+            return;
+
+        if (numAllocations.fetch_add (1, std::memory_order_relaxed) == 0)
+            firstAllocationSize.store (size, std::memory_order_relaxed);
+    }
+
+    void recordFree (void* ptr) noexcept
+    {
+        if (ptr != nullptr && isChecking.load (std::memory_order_relaxed))
+            numFrees.fetch_add (1, std::memory_order_relaxed);
+    }
+}
+
+ScopedAllocationCheck::ScopedAllocationCheck() noexcept
+{
+    numAllocations.store (0);
+    numFrees.store (0);
+    firstAllocationSize.store (0);
+
+    // Checks don't nest
+    const auto wasChecking = isChecking.exchange (true);
+    (void) wasChecking;
+}
+
+ScopedAllocationCheck::~ScopedAllocationCheck() noexcept
+{
+    isChecking.store (false);
+}
+
+int ScopedAllocationCheck::getNumAllocations() const noexcept     { return numAllocations.load(); }
+int ScopedAllocationCheck::getNumFrees() const noexcept           { return numFrees.load(); }
+size_t ScopedAllocationCheck::getFirstAllocationSize() const noexcept { return firstAllocationSize.load(); }
+
+//==============================================================================
+#if defined (__GLIBC__)
+
+// glibc lets an executable replace malloc and friends outright, which also catches operator new (it calls malloc),
+// C library functions and anything JUCE does under the hood. The originals stay reachable under their __libc_ names.
+extern "C"
+{
+    void* __libc_malloc (size_t);
+    void* __libc_calloc (size_t, size_t);
+    void* __libc_realloc (void*, size_t);
+    void* __libc_memalign (size_t, size_t);
+    void  __libc_free (void*);
+
+    void* malloc (size_t size) noexcept
+    {
+        recordAllocation (size);
+        return __libc_malloc (size);
+    }
+
+    void* calloc (size_t count, size_t size) noexcept
+    {
+        recordAllocation (count * size);
+        return __libc_calloc (count, size);
+    }
+
+    void* realloc (void* ptr, size_t size) noexcept
+    {
+        recordAllocation (size);
+        return __libc_realloc (ptr, size);
+    }
+
+    void free (void* ptr) noexcept
+    {
+        recordFree (ptr);
+        __libc_free (ptr);
+    }
+
+    void* memalign (size_t alignment, size_t size) noexcept
+    {
+        recordAllocation (size);
+        return __libc_memalign (alignment, size);
+    }
+
+    void* aligned_alloc (size_t alignment, size_t size) noexcept
+    {
+        recordAllocation (size);
+        return __libc_memalign (alignment, size);
+    }
+
+    int posix_memalign (void** result, size_t alignment, size_t size) noexcept
+    {
+        recordAllocation (size);
+        *result = __libc_memalign (alignment, size);
+        return *result != nullptr ? 0 : ENOMEM;
+    }
+}
+
+#else
+
+// Elsewhere the C library can't be replaced portably, so we settle for everything that goes through operator new and delete.
+// The over-aligned forms are left alone, they're only used for the voice pool, which is allocated in the constructor
+void* operator new (size_t size)
+{
+    recordAllocation (size);
+
+    if (auto* ptr = std::malloc (size == 0 ? 1 : size))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[] (size_t size)
+{
+    return operator new (size);
+}
+
+void* operator new (size_t size, const std::nothrow_t&) noexcept
+{
+    recordAllocation (size);
+    return std::malloc (size == 0 ? 1 : size);
+}
+
+void* operator new[] (size_t size, const std::nothrow_t& tag) noexcept
+{
+    return operator new (size, tag);
+}
+
+void operator delete (void* ptr) noexcept                              { recordFree (ptr); std::free (ptr); }
+void operator delete[] (void* ptr) noexcept                            { operator delete (ptr); }
+void operator delete (void* ptr, size_t) noexcept                      { operator delete (ptr); }
+void operator delete[] (void* ptr, size_t) noexcept                    { operator delete (ptr); }
+void operator delete (void* ptr, const std::nothrow_t&) noexcept       { operator delete (ptr); }
+void operator delete[] (void* ptr, const std::nothrow_t&) noexcept     { operator delete (ptr); }
+
+#endif
@@ -0,0 +1,33 @@
+/*
+  ==============================================================================
+
+    AllocationTracker.h
+    Created: 17 Oct 2026 6:02:48pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <cstddef>
+
+// The test executable replaces the heap functions (malloc and friends on glibc, operator new and delete elsewhere)
+// with versions that count every call made, on any thread, while a ScopedAllocationCheck is alive.
+// Wrap a processBlock call in one to prove the audio thread never touches the heap.
+class ScopedAllocationCheck
+{
+public:
+    ScopedAllocationCheck() noexcept;
+    ~ScopedAllocationCheck() noexcept;
+
+    int getNumAllocations() const noexcept;
+    int getNumFrees() const noexcept;
+
+    // The size of the first allocation that was counted, to help find where it came from
+    std::size_t getFirstAllocationSize() const noexcept;
+
+private:
+    ScopedAllocationCheck (const ScopedAllocationCheck&) = delete;
+    ScopedAllocationCheck& operator= (const ScopedAllocationCheck&) = delete;
+};
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    AnalyserFifoTests.cpp
+    Created: 18 Oct 2026 5:12:09am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AnalyserFifo.h"
+
+class AnalyserFifoTests : public juce::UnitTest
+{
+public:
+    AnalyserFifoTests()
+        : juce::UnitTest ("Analyser FIFO", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Nothing is copied while no reader is attached");
+        {
+            AnalyserFifo fifo (64);
+            fifo.push (makeBuffer (0.5f, -0.25f, 16), 16);
+
+            std::vector<float> read (64);
+            expectEquals (fifo.pop (read.data(), (int) read.size()), 0);
+            expectEquals ((int) fifo.getNumDropped(), 0);
+        }
+
+        beginTest ("The channels are averaged into one");
+        {
+            AnalyserFifo fifo (64);
+            fifo.setReaderAttached (true);
+            fifo.push (makeBuffer (0.5f, -0.25f, 16), 16);
+
+            std::vector<float> read (64);
+            expectEquals (fifo.pop (read.data(), (int) read.size()), 16);
+
+            for (int i = 0; i < 16; ++i)
+                expectEquals (read[(size_t) i], 0.125f);
+        }
+
+        beginTest ("Samples that don't fit are dropped and counted, and wrapping keeps their order");
+        {
+            AnalyserFifo fifo (64);
+            fifo.setReaderAttached (true);
+
+            // 64 slots hold 63 samples
+            auto ramp = makeBuffer (0.0f, 0.0f, 48);
+
+            for (int i = 0; i < 48; ++i)
+                for (int channel = 0; channel < ramp.getNumChannels(); ++channel)
+                    ramp.setSample (channel, i, (float) i);
+
+            fifo.push (ramp, 48);
+
+            std::vector<float> read (64);
+            expectEquals (fifo.pop (read.data(), 40), 40);
+
+            fifo.push (ramp, 48);
+            expectEquals ((int) fifo.getNumDropped(), 0);
+            fifo.push (ramp, 48);
+            expectEquals ((int) fifo.getNumDropped(), 48 - 7);
+
+            expectEquals (fifo.pop (read.data(), (int) read.size()), 63);
+            expectEquals (read[0], 40.0f);
+            expectEquals (read[8], 0.0f);
+            expectEquals (read[55], 47.0f);
+            expectEquals (read[62], 6.0f);
+        }
+
+        beginTest ("A new reader starts with what's pushed after it attached");
+        {
+            AnalyserFifo fifo (64);
+            fifo.setReaderAttached (true);
+            fifo.push (makeBuffer (1.0f, 1.0f, 8), 8);
+            fifo.setReaderAttached (false);
+
+            fifo.setReaderAttached (true);
+            fifo.push (makeBuffer (0.5f, 0.5f, 4), 4);
+
+            std::vector<float> read (64);
+            expectEquals (fifo.pop (read.data(), (int) read.size()), 4);
+            expectEquals (read[0], 0.5f);
+        }
+    }
+
+private:
+    static juce::AudioBuffer<float> makeBuffer (float left, float right, int numSamples)
+    {
+        juce::AudioBuffer<float> buffer (2, numSamples);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            buffer.setSample (0, i, left);
+            buffer.setSample (1, i, right);
+        }
+
+        return buffer;
+    }
+};
+
+static AnalyserFifoTests analyserFifoTests;
@@ -0,0 +1,195 @@
+/*
+  ==============================================================================
+
+    AudioThreadAllocationTests.cpp
+    Created: 17 Oct 2026 6:02:48pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+#include "AllocationTracker.h"
+
+namespace
+{
+
+constexpr double sampleRate = 48000.0;
+constexpr int preparedBlockSize = 256;
+
+// Fewer voices than some of the chords below, so stealing gets exercised too
+constexpr int numVoices = 8;
+
+// A prepared processor, plus everything needed to feed it blocks. Only processBlock itself runs inside the allocation check
+struct Harness
+{
+    Harness (bool voiceParallel, bool multiCore)
+        : processor (numVoices)
+    {
+        processor.getSynth().setVoiceParallelRendering (voiceParallel);
+        processor.getSynth().setMultiCoreRendering (multiCore);
+        processor.setRateAndBufferSizeDetails (sampleRate, preparedBlockSize);
+        processor.prepareToPlay (sampleRate, preparedBlockSize);
+
+        // As if the editor were open, so copying the output for its scope is checked as well
+        processor.getAnalyserFifo().setReaderAttached (true);
+
+        buffer.setSize (processor.getTotalNumOutputChannels(), 4 * preparedBlockSize);
+        midi.ensureSize (4096);
+    }
+
+    void noteOn (int noteNumber, int samplePosition)    { midi.addEvent (juce::MidiMessage::noteOn (1, noteNumber, 0.8f), samplePosition); }
+    void noteOff (int noteNumber, int samplePosition)   { midi.addEvent (juce::MidiMessage::noteOff (1, noteNumber), samplePosition); }
+
+    // Renders one block with whatever MIDI has been queued, and keeps count of the heap calls processBlock made
+    void renderBlock (int numSamples)
+    {
+        jassert (numSamples <= buffer.getNumSamples());
+
+        juce::AudioBuffer<float> block (buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+        block.clear();
+
+        {
+            ScopedAllocationCheck check;
+            processor.processBlock (block, midi);
+
+            const auto heapCalls = check.getNumAllocations() + check.getNumFrees();
+
+            if (heapCalls > 0 && totalHeapCalls == 0)
+                firstAllocationSize = check.getFirstAllocationSize();
+
+            totalHeapCalls += heapCalls;
+        }
+
+        for (int channel = 0; channel < block.getNumChannels(); ++channel)
+            peakLevel = juce::jmax (peakLevel, block.getMagnitude (channel, 0, numSamples));
+
+        midi.clear();
+    }
+
+    TapSynthAudioProcessor processor;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+
+    int totalHeapCalls { 0 };
+    size_t firstAllocationSize { 0 };
+    float peakLevel { 0.0f };
+};
+
+} // namespace
+
+//==============================================================================
+class AudioThreadAllocationTests : public juce::UnitTest
+{
+public:
+    AudioThreadAllocationTests()
+        : juce::UnitTest ("Audio thread allocations", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        struct Mode
+        {
+            const char* name;
+            bool voiceParallel, multiCore;
+        };
+
+        for (auto mode : { Mode { " (voice-parallel)", true, false },
+                           Mode { " (per voice)", false, false },
+                           Mode { " (voice-parallel, multi-core)", true, true } })
+        {
+
+            beginTest ("Notes starting and stopping" + juce::String (mode.name));
+            {
+                Harness harness (mode.voiceParallel, mode.multiCore);
+
+                for (int block = 0; block < 64; ++block)
+                {
+                    const auto chord = block / 4;
+
+                    if (block % 4 == 0)
+                        for (int note = 0; note < 4; ++note)
+                            harness.noteOn (48 + chord + note * 4, 17);
+
+                    if (block % 4 == 2)
+                        for (int note = 0; note < 4; ++note)
+                            harness.noteOff (48 + chord + note * 4, 100);
+
+                    harness.renderBlock (preparedBlockSize);
+                }
+
+                expectNoHeapCalls (harness);
+            }
+
+            beginTest ("Voice stealing" + juce::String (mode.name));
+            {
+                Harness harness (mode.voiceParallel, mode.multiCore);
+
+                for (int block = 0; block < 64; ++block)
+                {
+                    // Twelve held notes at a time on eight voices
+                    if (block % 2 == 0)
+                        for (int note = 0; note < 12; ++note)
+                            harness.noteOn (36 + (block * 5 + note * 7) % 60, note * 3);
+
+                    if (block % 8 == 7)
+                        for (int noteNumber = 36; noteNumber < 96; ++noteNumber)
+                            harness.noteOff (noteNumber, 0);
+
+                    harness.renderBlock (preparedBlockSize);
+                }
+
+                expectNoHeapCalls (harness);
+            }
+
+            beginTest ("Parameter changes on every block" + juce::String (mode.name));
+            {
+                Harness harness (mode.voiceParallel, mode.multiCore);
+                auto random = getRandom();
+
+                for (int note = 0; note < 6; ++note)
+                    harness.noteOn (50 + note * 3, 0);
+
+                for (int block = 0; block < 64; ++block)
+                {
+                    // Hosts change parameters from other threads, so this happens outside the check
+                    for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+                        if (auto* parameter = harness.processor.treeState.getParameter (ParameterSnapshot::getParameterId (i)))
+                            parameter->setValueNotifyingHost (random.nextFloat());
+
+                    harness.renderBlock (preparedBlockSize);
+                }
+
+                expectNoHeapCalls (harness);
+            }
+
+            beginTest ("Odd and oversized blocks" + juce::String (mode.name));
+            {
+                Harness harness (mode.voiceParallel, mode.multiCore);
+
+                for (auto numSamples : { 1, 7, 255, 256, preparedBlockSize * 3 + 5, 64, 1 })
+                {
+                    harness.noteOn (60 + numSamples % 12, 0);
+                    harness.renderBlock (numSamples);
+                }
+
+                expectNoHeapCalls (harness);
+            }
+        }
+    }
+
+private:
+    void expectNoHeapCalls (const Harness& harness)
+    {
+        expectEquals (harness.totalHeapCalls, 0,
+                      "processBlock touched the heap " + juce::String (harness.totalHeapCalls) + " times, the first allocation was "
+                        + juce::String ((juce::int64) harness.firstAllocationSize) + " bytes");
+
+        // Silence would pass trivially, so make sure the synth actually played
+        expectGreaterThan (harness.peakLevel, 0.0f);
+    }
+};
+
+static AudioThreadAllocationTests audioThreadAllocationTests;
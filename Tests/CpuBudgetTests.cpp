@@ -0,0 +1,122 @@
+/*
+  ==============================================================================
+
+    CpuBudgetTests.cpp
+    Created: 18 Oct 2026 6:21:15am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RegressionScenarios.h"
+
+#include <map>
+
+// Checks that every regression scenario renders within its budget of nanoseconds per sample per playing voice.
+// The budgets belong to the build machine: --update-budgets measures the scenarios and stores the results with some
+// headroom. These are in a category of their own so machines that are too busy to time anything can leave them out
+class CpuBudgetTests : public juce::UnitTest
+{
+public:
+    CpuBudgetTests()
+        : juce::UnitTest ("CPU budget", "TapSynth Performance")
+    {
+    }
+
+    void runTest() override
+    {
+       #if JUCE_DEBUG || TAPSYNTH_PROFILING
+        beginTest ("Skipped");
+        logMessage ("CPU budgets are only checked in optimised builds without profiling");
+        return;
+       #endif
+
+        const auto& options = RegressionOptions::get();
+        const auto budgetFile = options.referenceDirectory.getChildFile ("CpuBudgets.txt");
+        auto budgets = readBudgets (budgetFile);
+
+        for (auto& scenario : RegressionScenario::getAll())
+        {
+            beginTest (scenario.name);
+
+            const auto nanosPerVoiceSample = measure (scenario);
+            expect (std::isfinite (nanosPerVoiceSample) && nanosPerVoiceSample > 0.0, "Nothing played");
+
+            if (options.updateBudgets)
+            {
+                budgets[scenario.name] = nanosPerVoiceSample * headroom;
+                logMessage (juce::String (scenario.name) + ": " + juce::String (nanosPerVoiceSample, 1) + " ns per voice sample, budget "
+                            + juce::String (budgets[scenario.name], 1));
+                continue;
+            }
+
+            const auto budget = budgets.find (scenario.name);
+
+            // Budgets only hold for the machine that recorded them, so a machine without any has nothing to check against
+            if (budget == budgets.end())
+            {
+                logMessage ("Skipped, no budget in " + budgetFile.getFullPathName() + ", budgets are recorded per machine with "
+                            "TapSynthTests --category=\"TapSynth Performance\" --update-budgets");
+                continue;
+            }
+
+            logMessage (juce::String (scenario.name) + ": " + juce::String (nanosPerVoiceSample, 1) + " ns per voice sample, budget "
+                        + juce::String (budget->second, 1));
+            expectLessOrEqual (nanosPerVoiceSample, budget->second, "ns per sample per voice");
+        }
+
+        if (options.updateBudgets)
+            expect (writeBudgets (budgetFile, budgets), "Can't write " + budgetFile.getFullPathName());
+    }
+
+private:
+    // Recorded budgets leave this much room above what the build machine measured
+    static constexpr double headroom = 1.5;
+    static constexpr int numRuns = 5;
+
+    // The fastest of a few runs, since anything else the machine does only ever makes a run slower
+    static double measure (const RegressionScenario& scenario)
+    {
+        auto best = std::numeric_limits<double>::max();
+
+        for (int run = 0; run < numRuns; ++run)
+        {
+            const auto render = renderScenario (scenario);
+            best = juce::jmin (best, render.nanoseconds / juce::jmax (1.0, render.voiceSamples));
+        }
+
+        return best;
+    }
+
+    // One "scenario nanoseconds" pair per line
+    static std::map<juce::String, double> readBudgets (const juce::File& file)
+    {
+        std::map<juce::String, double> budgets;
+        juce::StringArray lines;
+        lines.addLines (file.loadFileAsString());
+
+        for (auto& line : lines)
+        {
+            const auto tokens = juce::StringArray::fromTokens (line.trim(), " \t", "");
+
+            if (tokens.size() == 2 && ! tokens[0].startsWith ("#"))
+                budgets[tokens[0]] = tokens[1].getDoubleValue();
+        }
+
+        return budgets;
+    }
+
+    static bool writeBudgets (const juce::File& file, const std::map<juce::String, double>& budgets)
+    {
+        juce::String text ("# ns per sample per playing voice, recorded by TapSynthTests --update-budgets\n");
+
+        for (auto& [name, budget] : budgets)
+            text << name << " " << juce::String (budget, 2) << "\n";
+
+        file.getParentDirectory().createDirectory();
+        return file.replaceWithText (text);
+    }
+};
+
+static CpuBudgetTests cpuBudgetTests;
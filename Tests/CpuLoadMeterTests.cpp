@@ -0,0 +1,113 @@
+/*
+  ==============================================================================
+
+    CpuLoadMeterTests.cpp
+    Created: 18 Oct 2026 4:36:27am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+class CpuLoadMeterTests : public juce::UnitTest
+{
+public:
+    CpuLoadMeterTests()
+        : juce::UnitTest ("CPU load meter", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Load settles on the share of the deadline the blocks take");
+        {
+            CpuLoadMeter meter;
+            meter.prepare (sampleRate);
+            addBlocks (meter, blockSize, 0.5 * deadline, 2.0);
+
+            expectWithinAbsoluteError (meter.getLoad(), 0.5f, 0.01f);
+            expectWithinAbsoluteError (meter.getPeakLoad(), 0.5f, 0.01f);
+            expectEquals ((int) meter.getNumNearMisses(), 0);
+            expectEquals ((int) meter.getNumMisses(), 0);
+        }
+
+        beginTest ("Near misses and misses are counted, and the peak holds the slowest block");
+        {
+            CpuLoadMeter meter;
+            meter.prepare (sampleRate);
+            addBlocks (meter, blockSize, 0.1 * deadline, 1.0);
+
+            meter.addBlock (blockSize, 0.9 * deadline);
+            meter.addBlock (blockSize, 0.85 * deadline);
+            meter.addBlock (blockSize, 1.2 * deadline);
+
+            expectEquals ((int) meter.getNumNearMisses(), 2);
+            expectEquals ((int) meter.getNumMisses(), 1);
+            expectWithinAbsoluteError (meter.getPeakLoad(), 1.2f, 0.001f);
+
+            // A single slow block barely moves the smoothed load
+            expectLessThan (meter.getLoad(), 0.3f);
+
+            // A second later the peak has fallen by half of its decay
+            addBlocks (meter, blockSize, 0.1 * deadline, 1.0);
+            expectWithinAbsoluteError (meter.getPeakLoad(), 1.2f * std::sqrt (0.1f), 0.01f);
+
+            meter.prepare (sampleRate);
+            expectEquals (meter.getLoad(), 0.0f);
+            expectEquals (meter.getPeakLoad(), 0.0f);
+            expectEquals ((int) meter.getNumNearMisses(), 0);
+            expectEquals ((int) meter.getNumMisses(), 0);
+        }
+
+        beginTest ("The same load reads the same at any block size");
+        {
+            CpuLoadMeter small, large;
+            small.prepare (sampleRate);
+            large.prepare (sampleRate);
+
+            addBlocks (small, 32, 0.6 * 32 / sampleRate, 0.2);
+            addBlocks (large, 1024, 0.6 * 1024 / sampleRate, 0.2);
+
+            expectWithinAbsoluteError (small.getLoad(), large.getLoad(), 0.02f);
+        }
+
+        beginTest ("The processor measures live blocks but not offline ones");
+        {
+            TapSynthAudioProcessor processor;
+            processor.setRateAndBufferSizeDetails (sampleRate, blockSize);
+            processor.prepareToPlay (sampleRate, blockSize);
+
+            juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), blockSize);
+            juce::MidiBuffer midi;
+
+            processor.setNonRealtime (true);
+            processor.processBlock (buffer, midi);
+            expectEquals (processor.getCpuLoadMeter().getPeakLoad(), 0.0f);
+
+            processor.setNonRealtime (false);
+            midi.addEvent (juce::MidiMessage::noteOn (1, 60, 0.8f), 0);
+            processor.processBlock (buffer, midi);
+            expectGreaterThan (processor.getCpuLoadMeter().getPeakLoad(), 0.0f);
+
+            processor.releaseResources();
+        }
+    }
+
+private:
+    // 480 samples at 48 kHz last 10 ms
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 480;
+    static constexpr double deadline = 0.01;
+
+    static void addBlocks (CpuLoadMeter& meter, int numSamples, double elapsedSeconds, double seconds)
+    {
+        const auto numBlocks = juce::roundToInt (seconds * sampleRate / numSamples);
+
+        for (int i = 0; i < numBlocks; ++i)
+            meter.addBlock (numSamples, elapsedSeconds);
+    }
+};
+
+static CpuLoadMeterTests cpuLoadMeterTests;
@@ -0,0 +1,115 @@
+/*
+  ==============================================================================
+
+    EnvelopeTests.cpp
+    Created: 17 Oct 2026 11:36:12pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "AdsrData.h"
+
+class EnvelopeTests : public juce::UnitTest
+{
+public:
+    EnvelopeTests()
+        : juce::UnitTest ("Envelope", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        constexpr int attackSamples = 1000, decaySamples = 2000, releaseSamples = 3000;
+        constexpr float sustain = 0.4f;
+
+        beginTest ("Segments take their set times and land on their levels");
+        {
+            auto envelope = makeEnvelope (sustain);
+            envelope.noteOn();
+
+            const auto held = render (envelope, attackSamples + decaySamples + 500);
+
+            for (int i = 1; i < attackSamples; ++i)
+                expectGreaterThan (held[(size_t) i], held[(size_t) i - 1]);
+
+            expectEquals (held[attackSamples - 1], 1.0f);
+            expectLessThan (held[attackSamples - 2], 1.0f);
+
+            for (int i = attackSamples; i < attackSamples + decaySamples; ++i)
+                expectLessOrEqual (held[(size_t) i], held[(size_t) i - 1]);
+
+            expectEquals (held[attackSamples + decaySamples - 1], sustain);
+            expectEquals (held.back(), sustain);
+            expect (envelope.isActive());
+
+            envelope.noteOff();
+            const auto released = render (envelope, releaseSamples + 10);
+
+            expectLessThan (released[releaseSamples - 2], sustain * 0.01f);
+            expectEquals (released[releaseSamples - 1], 0.0f);
+            expect (! envelope.isActive());
+        }
+
+        beginTest ("A note on during the release carries on from the current level");
+        {
+            auto envelope = makeEnvelope (sustain);
+            envelope.noteOn();
+            render (envelope, attackSamples + decaySamples);
+            envelope.noteOff();
+            render (envelope, 200);
+
+            const auto before = envelope.getLevel();
+            envelope.noteOn();
+            const auto after = render (envelope, 1);
+
+            expectGreaterThan (after[0], before);
+            expectLessThan (after[0] - before, 0.01f);
+        }
+
+        beginTest ("The output doesn't depend on the block size");
+        {
+            auto reference = makeEnvelope (sustain);
+            reference.noteOn();
+            const auto expected = render (reference, 4000);
+
+            for (auto blockSize : { 1, 7, 16, 100, 512 })
+            {
+                auto envelope = makeEnvelope (sustain);
+                envelope.noteOn();
+
+                std::vector<float> values (expected.size());
+
+                for (size_t start = 0; start < values.size(); start += (size_t) blockSize)
+                    envelope.process (values.data() + start, (int) juce::jmin ((size_t) blockSize, values.size() - start));
+
+                auto maxError = 0.0f;
+
+                for (size_t i = 0; i < values.size(); ++i)
+                    maxError = juce::jmax (maxError, std::abs (values[i] - expected[i]));
+
+                expectLessThan (maxError, 1.0e-5f, "Blocks of " + juce::String (blockSize));
+            }
+        }
+    }
+
+private:
+    static AdsrData makeEnvelope (float sustain)
+    {
+        // At 10 kHz the times below come out as 1000, 2000 and 3000 samples
+        AdsrData envelope;
+        envelope.setSampleRate (10000.0);
+        envelope.updateADSR (0.1f, 0.2f, sustain, 0.3f);
+        return envelope;
+    }
+
+    static std::vector<float> render (AdsrData& envelope, int numSamples)
+    {
+        std::vector<float> values ((size_t) numSamples);
+        envelope.process (values.data(), numSamples);
+        return values;
+    }
+};
+
+static EnvelopeTests envelopeTests;
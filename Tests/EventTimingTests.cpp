@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    EventTimingTests.cpp
+    Created: 17 Oct 2026 8:44:19pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessorTestHelpers.h"
+
+// The engine renders in fixed chunks, but notes still have to start and stop on the sample their MIDI event says
+class EventTimingTests : public juce::UnitTest
+{
+public:
+    EventTimingTests()
+        : juce::UnitTest ("Event timing", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        for (auto chunkSize : { 16, 128 })
+        {
+            beginTest ("Notes start on their sample, chunks of " + juce::String (chunkSize));
+
+            for (auto position : { 0, 1, 5, 15, 16, 63, 127, 128, 200, 255 })
+            {
+                const auto output = render (chunkSize, { juce::MidiMessage::noteOn (1, 60, 0.8f).withTimeStamp (position) });
+
+                expectStartsAt (output, position, "Note on at " + juce::String (position));
+            }
+
+            beginTest ("Notes stop on their sample, chunks of " + juce::String (chunkSize));
+
+            for (auto position : { 300, 301, 383, 384, 450 })
+            {
+                const auto held = render (chunkSize, { juce::MidiMessage::noteOn (1, 60, 0.8f).withTimeStamp (0) });
+                const auto released = render (chunkSize, { juce::MidiMessage::noteOn (1, 60, 0.8f).withTimeStamp (0),
+                                                           juce::MidiMessage::noteOff (1, 60).withTimeStamp (position) });
+
+                expectEquals (getFirstDifference (held, released), position, "Note off at " + juce::String (position));
+            }
+        }
+
+        beginTest ("Coarser event granularity moves events back to its grid");
+        {
+            const auto output = render (128, { juce::MidiMessage::noteOn (1, 60, 0.8f).withTimeStamp (45) }, 16);
+            expectStartsAt (output, 32, "Note on at 45");
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    static juce::AudioBuffer<float> render (int chunkSize, std::initializer_list<juce::MidiMessage> events, int granularity = 1)
+    {
+        constexpr int numBlocks = 4;
+
+        // Voices with queued events leave their SIMD group for the chunk, so render every voice on its own to compare runs exactly
+        TapSynthAudioProcessor processor (8);
+        processor.getSynth().setVoiceParallelRendering (false);
+        processor.getSynth().setChunkSize (chunkSize);
+        processor.getSynth().setEventGranularity (granularity);
+        prepareProcessor (processor, sampleRate, blockSize);
+
+        return renderBlocks (processor, numBlocks, events);
+    }
+
+    // Depending on the waveform the first sample of a note can land on a zero crossing, so the note may only be heard from the one after
+    void expectStartsAt (const juce::AudioBuffer<float>& buffer, int position, const juce::String& failureMessage)
+    {
+        auto firstNonZero = -1;
+
+        for (int i = 0; i < buffer.getNumSamples() && firstNonZero < 0; ++i)
+            if (buffer.getSample (0, i) != 0.0f)
+                firstNonZero = i;
+
+        expect (firstNonZero == position || firstNonZero == position + 1,
+                failureMessage + ", first heard at " + juce::String (firstNonZero));
+    }
+
+    static int getFirstDifference (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        for (int i = 0; i < a.getNumSamples(); ++i)
+            if (a.getSample (0, i) != b.getSample (0, i))
+                return i;
+
+        return -1;
+    }
+};
+
+static EventTimingTests eventTimingTests;
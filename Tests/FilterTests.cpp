@@ -0,0 +1,170 @@
+/*
+  ==============================================================================
+
+    FilterTests.cpp
+    Created: 18 Oct 2026 1:27:04am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FilterBank.h"
+
+class FilterTests : public juce::UnitTest
+{
+public:
+    FilterTests()
+        : juce::UnitTest ("Filters", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("The cutoff table follows tan() up to the highest cutoff");
+        {
+            const auto& table = CutoffTable::getInstance();
+            auto maxError = 0.0;
+
+            for (int i = 1; i <= 10000; ++i)
+            {
+                const auto omega = CutoffTable::maxOmega * i / 10000;
+                const auto expected = std::tan (omega);
+                maxError = juce::jmax (maxError, std::abs (table.getG ((float) omega) - expected) / expected);
+            }
+
+            expectLessThan (maxError, 1.0e-4);
+
+            // Beyond the end it holds the last value rather than reading past the table
+            expectWithinAbsoluteError (table.getG (10.0f), (float) std::tan (CutoffTable::maxOmega), 1.0e-3f);
+        }
+
+        beginTest ("Every model stays stable at full resonance");
+        {
+            for (int type = 0; type < FilterData::numTypes; ++type)
+            {
+                for (auto frequency : { 1000.0, 8000.0 })
+                {
+                    const auto gain = measureGain (type, 1000.0f, 10.0f, frequency);
+                    expect (std::isfinite (gain), "Type " + juce::String (type));
+                    expectLessThan (gain, 50.0f, "Type " + juce::String (type));
+                }
+            }
+        }
+
+        beginTest ("The 4-pole models roll off faster than the 2-pole lowpass");
+        {
+            const auto lowpass = measureGain (FilterData::lowpass, 1000.0f, 1.0f, 8000.0);
+            expectLessThan (measureGain (FilterData::lowpass24, 1000.0f, 1.0f, 8000.0), lowpass * 0.25f);
+            expectLessThan (measureGain (FilterData::ladder, 1000.0f, 1.0f, 8000.0), lowpass * 0.25f);
+
+            // All of them pass the bass
+            for (auto type : { FilterData::lowpass, FilterData::lowpass24, FilterData::ladder })
+                expectWithinAbsoluteError (measureGain (type, 1000.0f, 1.0f, 50.0), 1.0f, 0.05f);
+
+            expectGreaterThan (measureGain (FilterData::highpass, 1000.0f, 1.0f, 8000.0), 0.8f);
+        }
+
+       #if JUCE_USE_SIMD
+        beginTest ("The filter bank matches each voice's filter run on its own");
+        {
+            constexpr auto numLanes = FilterBank::numLanes;
+
+            for (int type = 0; type < FilterData::numTypes; ++type)
+            {
+                FilterBank bank;
+                bank.prepare (blockSize);
+
+                std::array<FilterData, (size_t) numLanes> banked, alone;
+                FilterData* bankedFilters[numLanes];
+
+                for (int lane = 0; lane < numLanes; ++lane)
+                {
+                    // Two lanes share a cutoff, so the bank's coefficient cache gets used
+                    const auto cutoff = 300.0f * (float) (1 + lane / 2);
+
+                    for (auto* filter : { &banked[(size_t) lane], &alone[(size_t) lane] })
+                    {
+                        filter->prepareToPlay (sampleRate, blockSize);
+                        filter->updateParameters (type, cutoff, 4.0f);
+                    }
+
+                    bankedFilters[lane] = &banked[(size_t) lane];
+                }
+
+                FilterBank::LaneBuffer laneSamples;
+                laneSamples.allocate (blockSize);
+                std::vector<float> modulation ((size_t) blockSize), input ((size_t) (numLanes * blockSize)), samples ((size_t) blockSize);
+                juce::Random random (type);
+                auto maxError = 0.0f;
+
+                for (int block = 0; block < 8; ++block)
+                {
+                    // The modulation sweeps the cutoffs up, so the coefficients change at every control point
+                    for (int i = 0; i < blockSize; ++i)
+                        modulation[(size_t) i] = 1.0f + (float) (block * blockSize + i) / 512.0f;
+
+                    for (auto& sample : input)
+                        sample = random.nextFloat() * 2.0f - 1.0f;
+
+                    for (int lane = 0; lane < numLanes; ++lane)
+                    {
+                        banked[(size_t) lane].beginBlock (modulation.data(), blockSize, &bank.getCoefficientCache());
+                        alone[(size_t) lane].beginBlock (modulation.data(), blockSize);
+
+                        for (int i = 0; i < blockSize; ++i)
+                            laneSamples.getSample (i)[lane] = input[(size_t) (lane * blockSize + i)];
+                    }
+
+                    bank.process (bankedFilters, laneSamples, blockSize);
+
+                    for (int lane = 0; lane < numLanes; ++lane)
+                    {
+                        std::copy_n (input.begin() + lane * blockSize, blockSize, samples.begin());
+                        alone[(size_t) lane].process (samples.data(), blockSize);
+
+                        for (int i = 0; i < blockSize; ++i)
+                            maxError = juce::jmax (maxError, std::abs (samples[(size_t) i] - laneSamples.getSample (i)[lane]));
+                    }
+                }
+
+                expectLessThan (maxError, 1.0e-4f, "Type " + juce::String (type));
+            }
+        }
+       #endif
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    // The peak of a sine at frequency after it has gone through the filter for half a second
+    static float measureGain (int type, float cutoff, float resonance, double frequency)
+    {
+        FilterData filter;
+        filter.prepareToPlay (sampleRate, blockSize);
+        filter.updateParameters (type, cutoff, resonance);
+
+        std::vector<float> modulation ((size_t) blockSize, 1.0f), samples ((size_t) blockSize);
+        const auto numBlocks = (int) (0.5 * sampleRate / blockSize);
+        auto peak = 0.0f;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (int i = 0; i < blockSize; ++i)
+                samples[(size_t) i] = (float) std::sin (juce::MathConstants<double>::twoPi * frequency * (block * blockSize + i) / sampleRate);
+
+            filter.beginBlock (modulation.data(), blockSize);
+            filter.process (samples.data(), blockSize);
+
+            // Only the last quarter counts, by then the filter has settled
+            if (block >= numBlocks * 3 / 4)
+                for (auto sample : samples)
+                    peak = juce::jmax (peak, std::abs (sample));
+        }
+
+        return peak;
+    }
+};
+
+static FilterTests filterTests;
@@ -0,0 +1,99 @@
+/*
+  ==============================================================================
+
+    GoldenOutputTests.cpp
+    Created: 18 Oct 2026 6:21:15am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RegressionScenarios.h"
+
+class GoldenOutputTests : public juce::UnitTest
+{
+public:
+    GoldenOutputTests()
+        : juce::UnitTest ("Golden output", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        const auto& options = RegressionOptions::get();
+
+        for (auto& scenario : RegressionScenario::getAll())
+        {
+            beginTest (scenario.name);
+
+            const auto render = renderScenario (scenario);
+            const auto& audio = render.audio;
+
+            // A scenario that renders silence or blows up would make a useless reference
+            auto peak = 0.0f;
+
+            for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+                peak = juce::jmax (peak, audio.getMagnitude (channel, 0, audio.getNumSamples()));
+
+            expect (std::isfinite (peak) && peak > 1.0e-3f && peak < 4.0f, "Peak level " + juce::String (peak));
+
+            const auto file = options.referenceDirectory.getChildFile (juce::String (scenario.name) + ".wav");
+
+            if (options.updateReferences)
+            {
+                expect (writeReferenceAudio (file, audio), "Can't write " + file.getFullPathName());
+                logMessage ("Recorded " + file.getFullPathName());
+                continue;
+            }
+
+            juce::AudioBuffer<float> reference;
+
+            // A scenario that hasn't been recorded yet has nothing to compare with. That's reported rather than failed, so a
+            // new scenario can land before its reference does
+            if (! file.existsAsFile())
+            {
+                logMessage ("Skipped, no reference audio at " + file.getFullPathName() + ", record it with TapSynthTests --update-golden");
+                continue;
+            }
+
+            if (! readReferenceAudio (file, reference))
+            {
+                expect (false, "Can't read " + file.getFullPathName());
+                continue;
+            }
+
+            expectEquals (audio.getNumChannels(), reference.getNumChannels(), "Channels");
+            expectEquals (audio.getNumSamples(), reference.getNumSamples(), "Length");
+
+            if (audio.getNumChannels() != reference.getNumChannels() || audio.getNumSamples() != reference.getNumSamples())
+                continue;
+
+            // Different compilers and SIMD widths round differently, but nothing that changes the sound gets through
+            auto maxError = 0.0f;
+            auto worstSample = 0;
+
+            for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+            {
+                for (int i = 0; i < audio.getNumSamples(); ++i)
+                {
+                    const auto error = std::abs (audio.getSample (channel, i) - reference.getSample (channel, i));
+
+                    if (error > maxError)
+                    {
+                        maxError = error;
+                        worstSample = i;
+                    }
+                }
+            }
+
+            expectLessOrEqual (maxError, tolerance, "Worst at " + juce::String ((double) worstSample / RegressionScenario::sampleRate, 4) + " s");
+        }
+    }
+
+private:
+    // -80 dB below full scale
+    static constexpr float tolerance = 1.0e-4f;
+};
+
+static GoldenOutputTests goldenOutputTests;
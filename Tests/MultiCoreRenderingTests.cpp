@@ -0,0 +1,106 @@
+/*
+  ==============================================================================
+
+    MultiCoreRenderingTests.cpp
+    Created: 17 Oct 2026 7:52:10pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessorTestHelpers.h"
+
+// Multi-core rendering has to produce exactly the same samples as rendering everything on the calling thread
+class MultiCoreRenderingTests : public juce::UnitTest
+{
+public:
+    MultiCoreRenderingTests()
+        : juce::UnitTest ("Multi-core rendering", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        juce::SharedResourcePointer<WorkStealingPool> pool;
+        logMessage ("Worker pool has " + juce::String (pool->getNumWorkers()) + " workers");
+
+        for (auto voiceParallel : { true, false })
+        {
+            beginTest (juce::String ("Output matches single threaded rendering") + (voiceParallel ? " (voice-parallel)" : " (per voice)"));
+
+            const auto reference = render (voiceParallel, false);
+            const auto multiCore = render (voiceParallel, true);
+
+            expectGreaterThan (reference.getMagnitude (0, reference.getNumSamples()), 0.0f);
+            expect (isIdentical (reference, multiCore), "Multi-core output differs from single threaded output");
+        }
+
+        beginTest ("Workers only start once they're asked for");
+        {
+            WorkStealingPool ownPool;
+            expect (! ownPool.areWorkersRunning());
+
+            // Until then everything runs on the calling thread
+            std::array<int, 64> participants {};
+            ownPool.run (&recordParticipant, participants.data(), (int) participants.size());
+            expect (std::all_of (participants.begin(), participants.end(), [] (int participant) { return participant == 0; }));
+
+            ownPool.startWorkers();
+            expect (ownPool.areWorkersRunning() == (ownPool.getNumWorkers() > 0));
+
+            participants.fill (-1);
+            ownPool.run (&recordParticipant, participants.data(), (int) participants.size());
+            expect (std::none_of (participants.begin(), participants.end(), [] (int participant) { return participant < 0; }));
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int blockSize = 128;
+    static constexpr int numBlocks = 200;
+
+    static juce::AudioBuffer<float> render (bool voiceParallel, bool multiCore)
+    {
+        TapSynthAudioProcessor processor (24);
+        processor.getSynth().setVoiceParallelRendering (voiceParallel);
+        processor.getSynth().setMultiCoreRendering (multiCore);
+        prepareProcessor (processor, sampleRate, blockSize);
+
+        // Some FM and a filter sweep so every voice does real work
+        for (auto [id, value] : { std::pair<const char*, float> { "OSC1WAVETYPE", 0.5f }, { "OSC1FMFREQ", 0.3f }, { "OSC1FMDEPTH", 0.4f },
+                                  { "FILTERFREQ", 0.5f }, { "FILTERRES", 0.3f }, { "PANSPREAD", 1.0f } })
+            processor.treeState.getParameter (id)->setValueNotifyingHost (value);
+
+        // Chords of 11 notes, so the voice-parallel mode has full SIMD groups as well as voices left over
+        std::vector<juce::MidiMessage> events;
+
+        for (int block = 0; block < numBlocks; block += 20)
+        {
+            for (int note = 0; note < 11; ++note)
+            {
+                const auto noteNumber = 40 + (block / 20) + note * 3;
+                events.push_back (juce::MidiMessage::noteOn (1, noteNumber, 0.7f).withTimeStamp (block * blockSize + (note * 13) % blockSize));
+                events.push_back (juce::MidiMessage::noteOff (1, noteNumber).withTimeStamp ((block + 12) * blockSize + 64));
+            }
+        }
+
+        return renderBlocks (processor, numBlocks, events);
+    }
+
+    static void recordParticipant (void* participants, int job, int participant)
+    {
+        static_cast<int*> (participants)[job] = participant;
+    }
+
+    static bool isIdentical (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            if (std::memcmp (a.getReadPointer (channel), b.getReadPointer (channel), sizeof (float) * (size_t) a.getNumSamples()) != 0)
+                return false;
+
+        return true;
+    }
+};
+
+static MultiCoreRenderingTests multiCoreRenderingTests;
@@ -0,0 +1,172 @@
+/*
+  ==============================================================================
+
+    OscillatorTests.cpp
+    Created: 18 Oct 2026 7:24:06am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessorTestHelpers.h"
+
+// Deep FM pushes the carrier's phase increment below zero, and the phase has to stay within [0, 1) on the way back,
+// or the wavetable read goes past the end of its table. The mip levels the oscillator reads have to change without steps
+class OscillatorTests : public juce::UnitTest
+{
+public:
+    OscillatorTests()
+        : juce::UnitTest ("Oscillator", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("A phase just below zero wraps to below one");
+        {
+            for (auto phase : { -1.0e-9f, -1.0e-8f, -std::numeric_limits<float>::denorm_min(), -0.5f, 1.0f, 1.5f - 1.0e-7f })
+            {
+                const auto wrapped = OscData::wrapPhase (phase);
+                expect (wrapped >= 0.0f && wrapped < 1.0f, juce::String (phase, 12) + " wrapped to " + juce::String (wrapped, 12));
+            }
+        }
+
+        beginTest ("The phase stays within [0, 1) with deep negative FM");
+        {
+            juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32) blockSize, 1 };
+
+            OscData oscillator;
+            oscillator.prepareToPlay (spec);
+            oscillator.setWaveType (1);
+            oscillator.setWaveFrequency (0);
+
+            // Far deeper than the parameter allows, so the increment spends most of its time against -0.5 or 0.5
+            oscillator.setFmParams (7.0f, 40000.0f);
+            oscillator.skipParameterRamps();
+
+            int numOutside = 0;
+            auto sample = 0.0f;
+
+            for (int block = 0; block < 200; ++block)
+            {
+                const auto setup = oscillator.beginBlock (blockSize);
+
+                for (int i = 0; i < blockSize; ++i)
+                {
+                    auto sampleSetup = setup;
+                    sampleSetup.increments += i;
+                    oscillator.render (sampleSetup, &sample, 1);
+                    const auto phase = oscillator.getPhase();
+                    numOutside += (phase >= 0.0f && phase < 1.0f) ? 0 : 1;
+                }
+            }
+
+            expectEquals (numOutside, 0);
+        }
+
+        beginTest ("Mip levels blend into each other without a step or aliasing");
+        {
+            auto lastPosition = WavetableBank::getLevelPosition (0.0f);
+            auto maxStep = 0.0f;
+            int numAliasing = 0;
+
+            for (auto increment = 1.0e-4f; increment < 0.5f; increment *= 1.001f)
+            {
+                const auto position = WavetableBank::getLevelPosition (increment);
+                maxStep = juce::jmax (maxStep, std::abs (position - lastPosition));
+                lastPosition = position;
+
+                // The brighter of the two levels being blended still keeps its highest harmonic below Nyquist
+                const auto numHarmonics = (WavetableBank::tableSize / 2) >> (int) position;
+                numAliasing += (float) numHarmonics * increment > 0.5f ? 1 : 0;
+            }
+
+            expectLessThan (maxStep, 0.01f);
+            expectEquals (numAliasing, 0);
+        }
+
+        beginTest ("Each block's blend carries on from where the last one ended");
+        {
+            juce::dsp::ProcessSpec spec { sampleRate, (juce::uint32) blockSize, 1 };
+
+            OscData oscillator;
+            oscillator.prepareToPlay (spec);
+            oscillator.setWaveType (1);
+            oscillator.setWaveFrequency (90);
+
+            // A modulator at 0 Hz doesn't move the pitch, but its growing depth moves the mip levels up through several boundaries
+            auto lastEnd = -1.0f;
+            auto maxJump = 0.0f;
+            int numLevelChanges = 0, lastLevel = -1;
+
+            for (int block = 0; block < 200; ++block)
+            {
+                oscillator.setFmParams (0.0f, 20.0f * (float) block);
+                const auto setup = oscillator.beginBlock (blockSize);
+                const auto level = getLevel (setup.table);
+                const auto start = (float) level + setup.mix;
+
+                if (lastEnd >= 0.0f)
+                    maxJump = juce::jmax (maxJump, std::abs (start - lastEnd));
+
+                numLevelChanges += (lastLevel >= 0 && level != lastLevel) ? 1 : 0;
+                lastLevel = level;
+                lastEnd = start + setup.mixIncrement * (float) blockSize;
+            }
+
+            expectGreaterOrEqual (numLevelChanges, 2);
+            expectLessThan (maxJump, 0.05f);
+        }
+
+        for (auto voiceParallel : { false, true })
+        {
+            beginTest (juce::String ("The voices' phases stay within [0, 1) with the deepest FM, ") + (voiceParallel ? "voice-parallel" : "one voice at a time"));
+
+            TapSynthAudioProcessor processor (8);
+            processor.getSynth().setVoiceParallelRendering (voiceParallel);
+            setParameter (processor, "OSC1WAVETYPE", 1.0f);
+            setParameter (processor, "OSC1FMFREQ", 3.0f);
+            setParameter (processor, "OSC1FMDEPTH", 1000.0f);
+            prepareProcessor (processor, sampleRate, blockSize);
+
+            juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), blockSize);
+            juce::MidiBuffer midi;
+
+            for (int note = 0; note < 8; ++note)
+                midi.addEvent (juce::MidiMessage::noteOn (1, note * 5, 0.8f), note);
+
+            int numOutside = 0;
+
+            for (int block = 0; block < 400; ++block)
+            {
+                renderBlock (processor, buffer, midi);
+
+                for (auto& voice : processor.getSynth().getVoicePool())
+                {
+                    const auto phase = voice.getOscillator().getPhase();
+                    numOutside += (phase >= 0.0f && phase < 1.0f) ? 0 : 1;
+                }
+            }
+
+            expectEquals (numOutside, 0);
+        }
+    }
+
+private:
+    static int getLevel (const float* table)
+    {
+        const auto& bank = WavetableBank::getInstance();
+
+        for (int level = 0; level < WavetableBank::numLevels; ++level)
+            if (bank.getTable (WavetableBank::saw, level) == table)
+                return level;
+
+        return -1;
+    }
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+};
+
+static OscillatorTests oscillatorTests;
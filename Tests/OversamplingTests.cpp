@@ -0,0 +1,102 @@
+/*
+  ==============================================================================
+
+    OversamplingTests.cpp
+    Created: 17 Oct 2026 9:48:05pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+class OversamplingTests : public juce::UnitTest
+{
+public:
+    OversamplingTests()
+        : juce::UnitTest ("Oversampling", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        for (auto factor : { 2, 4 })
+        {
+            beginTest ("Decimating by " + juce::String (factor) + " keeps the audio band and stops what would alias into it");
+
+            // 1 kHz passes, and a tone just below each rate halving's Nyquist would fold back down to 1 kHz
+            expectWithinAbsoluteError (getGainInDecibels (factor, 1000.0), 0.0, 0.1);
+            expectLessThan (getGainInDecibels (factor, outputRate - 1000.0), -80.0);
+
+            if (factor == 4)
+                expectLessThan (getGainInDecibels (factor, 2.0 * outputRate - 1000.0), -70.0);
+        }
+
+        beginTest ("The offline setting is used for offline renders");
+        {
+            TapSynthAudioProcessor processor;
+            processor.treeState.getParameter ("OVERSAMPLING")->setValueNotifyingHost (0.5f);
+            processor.treeState.getParameter ("OFFLINEOVERSAMPLING")->setValueNotifyingHost (1.0f);
+            processor.setRateAndBufferSizeDetails (outputRate, blockSize);
+            processor.prepareToPlay (outputRate, blockSize);
+
+            juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), blockSize);
+            juce::MidiBuffer midi;
+            midi.addEvent (juce::MidiMessage::noteOn (1, 69, 0.8f), 0);
+
+            buffer.clear();
+            processor.processBlock (buffer, midi);
+            expectEquals (processor.getSynth().getOversamplingFactor(), 2);
+
+            // The note carries on across the switch
+            processor.setNonRealtime (true);
+            midi.clear();
+            buffer.clear();
+            processor.processBlock (buffer, midi);
+            expectEquals (processor.getSynth().getOversamplingFactor(), 4);
+            expectGreaterThan (buffer.getMagnitude (0, 0, blockSize), 0.0f);
+        }
+    }
+
+private:
+    static constexpr double outputRate = 48000.0;
+    static constexpr int blockSize = 512;
+
+    // Runs a sine at the oversampled rate through a decimator and compares the RMS of what comes out with the sine's
+    static double getGainInDecibels (int factor, double frequency)
+    {
+        constexpr int numBlocks = 16;
+
+        HalfBandDecimator decimator;
+        decimator.setFactor (factor);
+
+        std::vector<float> input ((size_t) (blockSize * factor));
+        std::vector<float> output ((size_t) blockSize);
+        const auto increment = juce::MathConstants<double>::twoPi * frequency / (outputRate * factor);
+        double phase = 0.0;
+        double sumOfSquares = 0.0;
+
+        for (int block = 0; block < numBlocks; ++block)
+        {
+            for (auto& sample : input)
+            {
+                sample = (float) std::sin (phase);
+                phase += increment;
+            }
+
+            std::fill (output.begin(), output.end(), 0.0f);
+            decimator.process (input.data(), output.data(), blockSize);
+
+            // The first block is left out, while the filters settle
+            if (block > 0)
+                for (auto sample : output)
+                    sumOfSquares += (double) sample * sample;
+        }
+
+        const auto rms = std::sqrt (sumOfSquares / ((numBlocks - 1) * blockSize));
+        return juce::Decibels::gainToDecibels (rms * juce::MathConstants<double>::sqrt2, -200.0);
+    }
+};
+
+static OversamplingTests oversamplingTests;
@@ -0,0 +1,85 @@
+/*
+  ==============================================================================
+
+    ParameterSmoothingTests.cpp
+    Created: 17 Oct 2026 10:58:31pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "FilterData.h"
+
+class ParameterSmoothingTests : public juce::UnitTest
+{
+public:
+    ParameterSmoothingTests()
+        : juce::UnitTest ("Parameter smoothing", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Ramps glide linearly and stop at the target");
+        {
+            LinearRamp ramp;
+            ramp.prepare (1000.0, 0.01);
+
+            // The first value after prepare is taken as it is
+            ramp.setTargetValue (1.0f);
+            expect (! ramp.isRamping());
+            expectEquals (ramp.getCurrentValue(), 1.0f);
+
+            ramp.setTargetValue (2.0f);
+            expect (ramp.isRamping());
+
+            float values[16] {};
+            ramp.process (values, 4);
+
+            for (int i = 0; i < 4; ++i)
+                expectWithinAbsoluteError (values[i], 1.0f + 0.1f * (float) (i + 1), 1.0e-6f);
+
+            expectEquals (ramp.getValueAfter (6), 2.0f);
+
+            ramp.process (values, 16);
+            expectWithinAbsoluteError (values[5], 2.0f, 1.0e-6f);
+
+            for (int i = 6; i < 16; ++i)
+                expectEquals (values[i], 2.0f);
+
+            expect (! ramp.isRamping());
+        }
+
+        beginTest ("A cutoff change sweeps the filter instead of stepping it");
+        {
+            constexpr double sampleRate = 48000.0;
+            constexpr int blockSize = 512;
+
+            FilterData filter;
+            filter.prepareToPlay (sampleRate, blockSize);
+            filter.updateParameters (0, 200.0f, 1.0f);
+
+            std::vector<float> modulation ((size_t) blockSize, 1.0f);
+            filter.beginBlock (modulation.data(), blockSize);
+
+            filter.updateParameters (0, 8000.0f, 1.0f);
+            filter.beginBlock (modulation.data(), blockSize);
+
+            // The ramp takes longer than one block, so this block only gets partway there, without any jumps
+            const auto targetG = (float) std::tan (juce::MathConstants<double>::pi * 8000.0 / sampleRate);
+            const auto* g = filter.getG();
+
+            for (int i = 1; i < blockSize; ++i)
+                expectLessOrEqual (g[i] - g[i - 1], 0.01f);
+
+            expectLessThan (g[blockSize - 1], targetG);
+
+            filter.beginBlock (modulation.data(), blockSize);
+            filter.beginBlock (modulation.data(), blockSize);
+            expectWithinAbsoluteError (filter.getG()[blockSize - 1], targetG, 1.0e-5f);
+        }
+    }
+};
+
+static ParameterSmoothingTests parameterSmoothingTests;
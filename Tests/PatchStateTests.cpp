@@ -0,0 +1,199 @@
+/*
+  ==============================================================================
+
+    PatchStateTests.cpp
+    Created: 17 Oct 2026 3:40:02pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+class PatchStateTests : public juce::UnitTest
+{
+public:
+    PatchStateTests()
+        : juce::UnitTest ("Patch state", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("State round trips through the processor");
+        {
+            TapSynthAudioProcessor source;
+            setParameters (source, { { "OSC1WAVETYPE", 1.0f }, { "OSC1FMDEPTH", 0.25f }, { "ATTACK", 0.6f },
+                                     { "FILTERFREQ", 0.4f }, { "PANSPREAD", 0.75f } });
+
+            juce::MemoryBlock state;
+            source.getStateInformation (state);
+            expectEquals ((int) state.getSize(), (int) (PatchState::headerSize + ParameterSnapshot::numParameters * PatchState::floatFieldSize));
+
+            TapSynthAudioProcessor destination;
+            destination.setStateInformation (state.getData(), (int) state.getSize());
+
+            for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+                expectEquals (getPlainValue (destination, i), getPlainValue (source, i), ParameterSnapshot::getParameterId (i));
+        }
+
+        beginTest ("Unknown fields are skipped");
+        {
+            ParameterSnapshot written;
+            written[ParameterSnapshot::sustain] = 0.5f;
+            written[ParameterSnapshot::filterResonance] = 3.0f;
+
+            juce::MemoryBlock state;
+            PatchState::write (written, state);
+
+            // A field from some future version, with a payload longer than a float, put in front of the known ones
+            juce::MemoryBlock future;
+            future.append (state.getData(), PatchState::headerSize);
+            const char unknownField[] { (char) 0xee, (char) 0x7f, 6, 0, 1, 2, 3, 4, 5, 6 };
+            future.append (unknownField, sizeof (unknownField));
+            future.append (static_cast<const char*> (state.getData()) + PatchState::headerSize, state.getSize() - PatchState::headerSize);
+            static_cast<char*> (future.getData())[6] = (char) (ParameterSnapshot::numParameters + 1);
+
+            ParameterSnapshot read;
+            std::bitset<ParameterSnapshot::numParameters> isPresent;
+            expect (PatchState::read (future.getData(), future.getSize(), read, isPresent));
+            expect (isPresent.all());
+            expect (read.values == written.values);
+        }
+
+        beginTest ("Truncated or foreign data is rejected");
+        {
+            ParameterSnapshot written;
+            written[ParameterSnapshot::attack] = 0.2f;
+
+            juce::MemoryBlock state;
+            PatchState::write (written, state);
+
+            ParameterSnapshot read;
+            read[ParameterSnapshot::attack] = 0.7f;
+            std::bitset<ParameterSnapshot::numParameters> isPresent;
+
+            for (size_t size = 0; size < state.getSize(); ++size)
+                expect (! PatchState::read (state.getData(), size, read, isPresent), "Accepted " + juce::String ((int) size) + " bytes");
+
+            // A failed read leaves the snapshot as it was
+            expectEquals (read[ParameterSnapshot::attack], 0.7f);
+
+            const char xml[] = "<?xml version=\"1.0\"?>";
+            expect (! PatchState::read (xml, sizeof (xml), read, isPresent));
+        }
+
+        beginTest ("State from a newer version is rejected");
+        {
+            ParameterSnapshot written;
+            juce::MemoryBlock state;
+            PatchState::write (written, state);
+            static_cast<char*> (state.getData())[4] = (char) (PatchState::currentVersion + 1);
+
+            ParameterSnapshot read;
+            std::bitset<ParameterSnapshot::numParameters> isPresent;
+            expect (! PatchState::read (state.getData(), state.getSize(), read, isPresent));
+
+            // The processor keeps its patch
+            TapSynthAudioProcessor processor;
+            setParameters (processor, { { "DECAY", 0.9f } });
+            const auto decayBefore = processor.treeState.getParameter ("DECAY")->getValue();
+
+            processor.setStateInformation (state.getData(), (int) state.getSize());
+            expectEquals (processor.treeState.getParameter ("DECAY")->getValue(), decayBefore);
+        }
+
+        beginTest ("Values that aren't finite or are out of range are sanitised");
+        {
+            TapSynthAudioProcessor source;
+            ParameterSnapshot written;
+            ParameterSnapshotReader (source.treeState).read (written);
+            written[ParameterSnapshot::filterFrequency] = std::numeric_limits<float>::quiet_NaN();
+            written[ParameterSnapshot::attack] = std::numeric_limits<float>::infinity();
+            written[ParameterSnapshot::filterResonance] = 1.0e6f;
+            written[ParameterSnapshot::oscWaveType] = -7.0f;
+
+            juce::MemoryBlock state;
+            PatchState::write (written, state);
+
+            ParameterSnapshot read;
+            std::bitset<ParameterSnapshot::numParameters> isPresent;
+            expect (PatchState::read (state.getData(), state.getSize(), read, isPresent));
+            expect (! isPresent[ParameterSnapshot::filterFrequency]);
+            expect (! isPresent[ParameterSnapshot::attack]);
+            expect (isPresent[ParameterSnapshot::filterResonance]);
+
+            TapSynthAudioProcessor processor;
+            setParameters (processor, { { "FILTERFREQ", 0.3f }, { "ATTACK", 0.8f }, { "OSC1WAVETYPE", 1.0f } });
+            processor.setStateInformation (state.getData(), (int) state.getSize());
+
+            for (auto id : { "FILTERFREQ", "ATTACK" })
+                expectEquals (processor.treeState.getParameter (id)->getValue(), processor.treeState.getParameter (id)->getDefaultValue(), id);
+
+            expectEquals (processor.treeState.getParameter ("FILTERRES")->getValue(), 1.0f);
+            expectEquals (processor.treeState.getParameter ("OSC1WAVETYPE")->getValue(), 0.0f);
+
+            // Programs in a bank are played by the audio thread as they are, so they're sanitised when the bank loads
+            ParameterSnapshot program;
+            program[ParameterSnapshot::filterResonance] = std::numeric_limits<float>::quiet_NaN();
+            program[ParameterSnapshot::filterFrequency] = 1.0e9f;
+            ParameterSnapshotWriter (processor.treeState).sanitise (program);
+            expect (std::isfinite (program[ParameterSnapshot::filterResonance]));
+            expectEquals (program[ParameterSnapshot::filterFrequency], 20000.0f);
+        }
+
+        beginTest ("Empty state from older versions gives the default patch");
+        {
+            TapSynthAudioProcessor processor;
+            setParameters (processor, { { "DECAY", 0.9f }, { "PANSPREAD", 0.2f } });
+
+            processor.setStateInformation (nullptr, 0);
+
+            for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+            {
+                auto* parameter = processor.treeState.getParameter (ParameterSnapshot::getParameterId (i));
+                expectEquals (parameter->getValue(), parameter->getDefaultValue(), ParameterSnapshot::getParameterId (i));
+            }
+        }
+
+        beginTest ("Parameters missing from old state go back to their defaults");
+        {
+            TapSynthAudioProcessor processor;
+            auto* newest = processor.treeState.getParameter (ParameterSnapshot::getParameterId (ParameterSnapshot::numParameters - 1));
+            newest->setValueNotifyingHost (newest->getDefaultValue() < 0.5f ? 1.0f : 0.0f);
+            setParameters (processor, { { "DECAY", 0.9f } });
+
+            // State from before the newest parameter existed: every field but the last
+            ParameterSnapshot written;
+            ParameterSnapshotReader (processor.treeState).read (written);
+
+            juce::MemoryBlock state;
+            PatchState::write (written, state);
+            state.setSize (state.getSize() - PatchState::floatFieldSize);
+            static_cast<char*> (state.getData())[6] = (char) (ParameterSnapshot::numParameters - 1);
+
+            auto* decay = processor.treeState.getParameter ("DECAY");
+            const auto decayBefore = decay->getValue();
+
+            processor.setStateInformation (state.getData(), (int) state.getSize());
+
+            expectEquals (newest->getValue(), newest->getDefaultValue());
+            expectEquals (decay->getValue(), decayBefore);
+        }
+    }
+
+private:
+    static void setParameters (TapSynthAudioProcessor& processor, std::initializer_list<std::pair<const char*, float>> values)
+    {
+        for (auto [id, value] : values)
+            processor.treeState.getParameter (id)->setValueNotifyingHost (value);
+    }
+
+    static float getPlainValue (TapSynthAudioProcessor& processor, int index)
+    {
+        return processor.treeState.getRawParameterValue (ParameterSnapshot::getParameterId (index))->load();
+    }
+};
+
+static PatchStateTests patchStateTests;
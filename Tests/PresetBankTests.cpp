@@ -0,0 +1,209 @@
+/*
+  ==============================================================================
+
+    PresetBankTests.cpp
+    Created: 17 Oct 2026 5:21:44pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessorTestHelpers.h"
+
+class PresetBankTests : public juce::UnitTest
+{
+public:
+    PresetBankTests()
+        : juce::UnitTest ("Preset bank", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        const auto bankFile = juce::File::createTempFile (".tsbank");
+        const auto presets = makePresets (400);
+        expect (PresetBank::write (bankFile, presets));
+
+        beginTest ("Programs and names load from the mapped file");
+        {
+            TapSynthAudioProcessor processor;
+            expect (processor.loadPresetBank (bankFile));
+            expectEquals (processor.getNumPrograms(), (int) presets.size());
+            expectEquals (processor.getProgramName (0), presets.front().name);
+            expectEquals (processor.getProgramName (399), presets.back().name);
+
+            processor.changeProgramName (7, "Renamed");
+            expectEquals (processor.getProgramName (7), juce::String ("Renamed"));
+        }
+
+        beginTest ("Only the bank the processor is given is loaded");
+        {
+            TapSynthAudioProcessor withBank (SynthEngine::defaultNumVoices, bankFile);
+            expectEquals (withBank.getNumPrograms(), (int) presets.size());
+
+            TapSynthAudioProcessor withoutBank;
+            expectEquals (withoutBank.getNumPrograms(), 1);
+        }
+
+        beginTest ("Selecting a program sets the parameters");
+        {
+            TapSynthAudioProcessor processor;
+            expect (processor.loadPresetBank (bankFile));
+            processor.setCurrentProgram (123);
+
+            expectEquals (processor.getCurrentProgram(), 123);
+
+            // The values go through the parameters' normalised ranges on the way, so allow for rounding
+            for (int i = 0; i < ParameterSnapshot::numParameters; ++i)
+            {
+                const auto expected = presets[123].parameters[i];
+                expectWithinAbsoluteError (processor.treeState.getRawParameterValue (ParameterSnapshot::getParameterId (i))->load(),
+                                           expected, 1.0e-3f * juce::jmax (1.0f, std::abs (expected)), ParameterSnapshot::getParameterId (i));
+            }
+        }
+
+        beginTest ("MIDI program changes switch the whole patch on the audio thread");
+        {
+            // Bank select 2 and program 3 is program 2 * 128 + 3
+            constexpr int program = 259;
+
+            const std::vector<juce::MidiMessage> programChange { juce::MidiMessage::controllerEvent (1, 0, 0),
+                                                                 juce::MidiMessage::controllerEvent (1, 32, 2),
+                                                                 juce::MidiMessage::programChange (1, 3) };
+
+            TapSynthAudioProcessor viaMidi;
+            expect (viaMidi.loadPresetBank (bankFile));
+            const auto midiOutput = render (viaMidi, programChange);
+            expectEquals (viaMidi.getCurrentProgram(), program);
+
+            TapSynthAudioProcessor viaHost;
+            expect (viaHost.loadPresetBank (bankFile));
+            viaHost.setCurrentProgram (program);
+            const auto hostOutput = render (viaHost, {});
+
+            TapSynthAudioProcessor unchanged;
+            expect (unchanged.loadPresetBank (bankFile));
+            const auto unchangedOutput = render (unchanged, {});
+
+            expectGreaterThan (midiOutput.getMagnitude (0, midiOutput.getNumSamples()), 0.0f);
+            expectLessThan (getMaxDifference (midiOutput, hostOutput), 1.0e-3f);
+            expectGreaterThan (getMaxDifference (midiOutput, unchangedOutput), 1.0e-2f);
+        }
+
+        beginTest ("A program change doesn't carry over into the next piece");
+        {
+            // What TapSynthRender does with each file: reset, restore the patch, prepare and play. Only the first has a program change
+            TapSynthAudioProcessor reused;
+            expect (reused.loadPresetBank (bankFile));
+
+            juce::MemoryBlock patch;
+            reused.getStateInformation (patch);
+
+            const auto firstOutput = render (reused, { juce::MidiMessage::controllerEvent (1, 0, 0),
+                                                       juce::MidiMessage::controllerEvent (1, 32, 2),
+                                                       juce::MidiMessage::programChange (1, 3) });
+
+            reused.resetPlaybackState();
+            reused.setStateInformation (patch.getData(), (int) patch.getSize());
+            const auto secondOutput = render (reused, {});
+            expectEquals (reused.getCurrentProgram(), 0);
+
+            TapSynthAudioProcessor fresh;
+            expect (fresh.loadPresetBank (bankFile));
+            const auto freshOutput = render (fresh, {});
+
+            expectGreaterThan (getMaxDifference (firstOutput, freshOutput), 1.0e-2f);
+            expectLessThan (getMaxDifference (secondOutput, freshOutput), 1.0e-3f);
+
+            // The bank select went with it, so a program change on its own picks from the first 128 again
+            reused.resetPlaybackState();
+            render (reused, { juce::MidiMessage::programChange (1, 3) });
+            expectEquals (reused.getCurrentProgram(), 3);
+        }
+
+        beginTest ("Loading a new bank retires the old program IDs");
+        {
+            TapSynthAudioProcessor processor;
+            const ParameterSnapshotWriter parameters (processor.treeState);
+            PresetBank bank;
+            expect (bank.load (bankFile, parameters));
+
+            const auto* first = bank.getBank();
+            const auto oldId = PresetBank::makeProgramId (*first, 10);
+            expect (first->findProgram (oldId) == &first->programs[10]);
+
+            expect (bank.load (bankFile, parameters));
+            expect (bank.getBank()->findProgram (oldId) == nullptr);
+            expect (bank.getBank()->findProgram (PresetBank::makeProgramId (*bank.getBank(), 10)) != nullptr);
+        }
+
+        beginTest ("Damaged banks are rejected and the current bank is kept");
+        {
+            juce::MemoryBlock data;
+            bankFile.loadFileAsData (data);
+
+            const auto damagedFile = juce::File::createTempFile (".tsbank");
+            damagedFile.replaceWithData (data.getData(), data.getSize() - 3);
+
+            TapSynthAudioProcessor processor;
+            expect (processor.loadPresetBank (bankFile));
+            expect (! processor.loadPresetBank (damagedFile));
+            expectEquals (processor.getNumPrograms(), (int) presets.size());
+
+            damagedFile.deleteFile();
+        }
+
+        bankFile.deleteFile();
+    }
+
+private:
+    static constexpr double sampleRate = 44100.0;
+    static constexpr int blockSize = 256;
+
+    static std::vector<PresetBank::Preset> makePresets (int numPresets)
+    {
+        // Read the defaults from a processor, then vary the parameters that are easy to hear
+        TapSynthAudioProcessor processor;
+        ParameterSnapshot defaults;
+        ParameterSnapshotReader (processor.treeState).read (defaults);
+
+        std::vector<PresetBank::Preset> presets ((size_t) numPresets);
+
+        for (int i = 0; i < numPresets; ++i)
+        {
+            auto& preset = presets[(size_t) i];
+            preset.name = "Preset " + juce::String (i);
+            preset.parameters = defaults;
+            preset.parameters[ParameterSnapshot::oscWaveType] = (float) (i % 3);
+            preset.parameters[ParameterSnapshot::fmDepth] = (float) (i % 50);
+            preset.parameters[ParameterSnapshot::filterFrequency] = 200.0f + 40.0f * (float) (i % 100);
+            preset.parameters[ParameterSnapshot::panSpread] = (float) (i % 5) * 0.25f;
+        }
+
+        return presets;
+    }
+
+    // Plays a chord in the second block after the given MIDI, which goes at the start of the first
+    static juce::AudioBuffer<float> render (TapSynthAudioProcessor& processor, std::vector<juce::MidiMessage> events)
+    {
+        for (auto note : { 48, 55, 64, 71 })
+            events.push_back (juce::MidiMessage::noteOn (1, note, 0.8f).withTimeStamp (blockSize + 17));
+
+        prepareProcessor (processor, sampleRate, blockSize);
+        return renderBlocks (processor, 40, events);
+    }
+
+    static float getMaxDifference (const juce::AudioBuffer<float>& a, const juce::AudioBuffer<float>& b)
+    {
+        auto difference = 0.0f;
+
+        for (int channel = 0; channel < a.getNumChannels(); ++channel)
+            for (int i = 0; i < a.getNumSamples(); ++i)
+                difference = juce::jmax (difference, std::abs (a.getSample (channel, i) - b.getSample (channel, i)));
+
+        return difference;
+    }
+};
+
+static PresetBankTests presetBankTests;
@@ -0,0 +1,58 @@
+/*
+  ==============================================================================
+
+    ProcessorTestHelpers.cpp
+    Created: 18 Oct 2026 6:58:40am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "ProcessorTestHelpers.h"
+
+void setParameter (TapSynthAudioProcessor& processor, const char* id, float plainValue)
+{
+    auto* parameter = processor.treeState.getParameter (id);
+    jassert (parameter != nullptr);
+    parameter->setValueNotifyingHost (parameter->convertTo0to1 (plainValue));
+}
+
+void prepareProcessor (TapSynthAudioProcessor& processor, double sampleRate, int blockSize)
+{
+    processor.setRateAndBufferSizeDetails (sampleRate, blockSize);
+    processor.prepareToPlay (sampleRate, blockSize);
+}
+
+void renderBlock (TapSynthAudioProcessor& processor, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi)
+{
+    buffer.clear();
+    processor.processBlock (buffer, midi);
+    midi.clear();
+}
+
+juce::AudioBuffer<float> renderBlocks (TapSynthAudioProcessor& processor, int numBlocks, const std::vector<juce::MidiMessage>& events)
+{
+    const auto blockSize = processor.getBlockSize();
+
+    juce::AudioBuffer<float> output (processor.getTotalNumOutputChannels(), numBlocks * blockSize);
+    output.clear();
+
+    juce::MidiBuffer midi;
+
+    for (int block = 0; block < numBlocks; ++block)
+    {
+        for (auto& event : events)
+        {
+            const auto position = juce::roundToInt (event.getTimeStamp());
+
+            if (position / blockSize == block)
+                midi.addEvent (event, position % blockSize);
+        }
+
+        juce::AudioBuffer<float> view (output.getArrayOfWritePointers(), output.getNumChannels(), block * blockSize, blockSize);
+        processor.processBlock (view, midi);
+        midi.clear();
+    }
+
+    return output;
+}
@@ -0,0 +1,29 @@
+/*
+  ==============================================================================
+
+    ProcessorTestHelpers.h
+    Created: 18 Oct 2026 6:58:40am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// What most of the tests do with a processor: prepare it, set some parameters, feed it MIDI and keep what it played
+
+// Sets a parameter to a plain value, the way a host would
+void setParameter (TapSynthAudioProcessor& processor, const char* id, float plainValue);
+
+// Prepares the processor to render blocks of blockSize samples
+void prepareProcessor (TapSynthAudioProcessor& processor, double sampleRate, int blockSize);
+
+// Renders one block into buffer with the given MIDI, clearing the buffer first and the MIDI afterwards
+void renderBlock (TapSynthAudioProcessor& processor, juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi);
+
+// Renders numBlocks blocks of the block size the processor was prepared with, and returns all of them.
+// Each event goes into the block that its time stamp, in samples from the start of the first block, falls in
+juce::AudioBuffer<float> renderBlocks (TapSynthAudioProcessor& processor, int numBlocks, const std::vector<juce::MidiMessage>& events);
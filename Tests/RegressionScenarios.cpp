@@ -0,0 +1,226 @@
+/*
+  ==============================================================================
+
+    RegressionScenarios.cpp
+    Created: 18 Oct 2026 6:21:15am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include "RegressionScenarios.h"
+#include "ProcessorTestHelpers.h"
+
+#include <chrono>
+
+RegressionOptions& RegressionOptions::get()
+{
+    static RegressionOptions options;
+    return options;
+}
+
+const std::vector<RegressionScenario>& RegressionScenario::getAll()
+{
+    using Path = RegressionScenario::Path;
+
+    // Between them these cover every wave, FM, every filter model, both envelopes, stealing and oversampling.
+    // Changing one changes its reference audio, so record the references again afterwards
+    static const std::vector<RegressionScenario> scenarios
+    {
+        { "voice-sine", Path::voice, 1,
+          { { "FILTERFREQ", 5000.0f }, { "SUSTAIN", 0.6f } },
+          { { 57, 0.8f, 0.0, 0.4 } },
+          0.75 },
+
+        { "voice-saw-fm-lowpass", Path::voice, 1,
+          { { "OSC1WAVETYPE", 1.0f }, { "OSC1FMFREQ", 5.0f }, { "OSC1FMDEPTH", 40.0f }, { "FILTERFREQ", 2000.0f }, { "FILTERRES", 3.0f },
+            { "MODATTACK", 0.2f }, { "MODSUSTAIN", 0.5f } },
+          { { 48, 1.0f, 0.0, 0.3 }, { 55, 0.5f, 0.35, 0.2 } },
+          1.0 },
+
+        { "voice-square-ladder", Path::voice, 1,
+          { { "OSC1WAVETYPE", 2.0f }, { "FILTERTYPE", 4.0f }, { "FILTERFREQ", 800.0f }, { "FILTERRES", 7.0f },
+            { "ATTACK", 0.1f }, { "DECAY", 0.3f }, { "SUSTAIN", 0.3f }, { "RELEASE", 0.2f }, { "MODDECAY", 0.4f }, { "MODSUSTAIN", 0.2f } },
+          { { 40, 0.9f, 0.0, 0.5 } },
+          0.9 },
+
+        { "processor-chords-lowpass24", Path::processor, 8,
+          { { "OSC1WAVETYPE", 1.0f }, { "FILTERTYPE", 3.0f }, { "FILTERFREQ", 3000.0f }, { "FILTERRES", 2.0f }, { "PANSPREAD", 0.5f } },
+          { { 48, 0.8f, 0.0, 0.4 }, { 52, 0.7f, 0.0, 0.4 }, { 55, 0.7f, 0.0, 0.4 }, { 59, 0.6f, 0.0, 0.4 },
+            { 50, 0.8f, 0.45, 0.3 }, { 53, 0.7f, 0.46, 0.3 }, { 57, 0.7f, 0.47, 0.3 }, { 60, 0.6f, 0.48, 0.3 } },
+          1.2 },
+
+        { "processor-steal-bandpass", Path::processor, 4,
+          { { "OSC1WAVETYPE", 2.0f }, { "FILTERTYPE", 1.0f }, { "FILTERFREQ", 1500.0f }, { "FILTERRES", 4.0f }, { "PANSPREAD", 1.0f },
+            { "VOICESTEAL", 0.0f } },
+          { { 60, 0.8f, 0.0, 0.5 }, { 64, 0.8f, 0.05, 0.5 }, { 67, 0.8f, 0.1, 0.5 }, { 71, 0.8f, 0.15, 0.5 },
+            { 74, 0.8f, 0.2, 0.3 }, { 77, 0.8f, 0.25, 0.3 } },
+          1.0 },
+
+        { "processor-oversampled-highpass", Path::processor, 8,
+          { { "OSC1WAVETYPE", 1.0f }, { "OSC1FMFREQ", 220.0f }, { "OSC1FMDEPTH", 300.0f }, { "FILTERTYPE", 2.0f }, { "FILTERFREQ", 400.0f },
+            { "OVERSAMPLING", 1.0f } },
+          { { 72, 0.8f, 0.0, 0.3 }, { 79, 0.6f, 0.1, 0.3 } },
+          0.8 }
+    };
+
+    return scenarios;
+}
+
+namespace
+{
+
+// The note ons and offs of the scenario's notes that fall into one block
+void fillBlock (const RegressionScenario& scenario, juce::MidiBuffer& midi, juce::int64 blockStart, int numSamples)
+{
+    midi.clear();
+
+    auto addIfInBlock = [&] (const juce::MidiMessage& message, double seconds)
+    {
+        const auto position = (juce::int64) std::llround (seconds * RegressionScenario::sampleRate) - blockStart;
+
+        if (position >= 0 && position < numSamples)
+            midi.addEvent (message, (int) position);
+    };
+
+    for (auto& note : scenario.notes)
+    {
+        addIfInBlock (juce::MidiMessage::noteOn (1, note.noteNumber, note.velocity), note.startSeconds);
+        addIfInBlock (juce::MidiMessage::noteOff (1, note.noteNumber), note.startSeconds + note.lengthSeconds);
+    }
+}
+
+// The same calls the processor makes when every parameter has changed
+void applyParameters (SynthVoice& voice, const ParameterSnapshot& parameters)
+{
+    voice.getOscillator().setWaveType ((int) parameters[ParameterSnapshot::oscWaveType]);
+    voice.getOscillator().setFmParams (parameters[ParameterSnapshot::fmFrequency], parameters[ParameterSnapshot::fmDepth]);
+    voice.updateAdsr (parameters[ParameterSnapshot::attack], parameters[ParameterSnapshot::decay], parameters[ParameterSnapshot::sustain], parameters[ParameterSnapshot::release]);
+    voice.updateFilter ((int) parameters[ParameterSnapshot::filterType], parameters[ParameterSnapshot::filterFrequency], parameters[ParameterSnapshot::filterResonance]);
+    voice.updateModAdsr (parameters[ParameterSnapshot::modAttack], parameters[ParameterSnapshot::modDecay], parameters[ParameterSnapshot::modSustain], parameters[ParameterSnapshot::modRelease]);
+    voice.setPanSpread (parameters[ParameterSnapshot::panSpread]);
+}
+
+// Renders the scenario block by block. renderBlock does the work that's timed, countVoices says how many voices played
+template <typename RenderBlock, typename CountVoices>
+RegressionRender renderBlocks (const RegressionScenario& scenario, int numChannels, RenderBlock&& renderBlock, CountVoices&& countVoices)
+{
+    using Clock = std::chrono::steady_clock;
+
+    const auto totalSamples = (int) std::llround (scenario.seconds * RegressionScenario::sampleRate);
+
+    RegressionRender render;
+    render.audio.setSize (numChannels, totalSamples);
+    render.audio.clear();
+
+    juce::AudioBuffer<float> block (numChannels, RegressionScenario::blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize (1024);
+
+    for (int position = 0; position < totalSamples; position += RegressionScenario::blockSize)
+    {
+        const auto numSamples = juce::jmin (RegressionScenario::blockSize, totalSamples - position);
+        juce::AudioBuffer<float> chunk (block.getArrayOfWritePointers(), numChannels, numSamples);
+        chunk.clear();
+        fillBlock (scenario, midi, position, numSamples);
+
+        const auto start = Clock::now();
+        renderBlock (chunk, midi);
+        render.nanoseconds += std::chrono::duration<double, std::nano> (Clock::now() - start).count();
+
+        render.voiceSamples += (double) countVoices() * numSamples;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+            render.audio.copyFrom (channel, position, chunk, channel, 0, numSamples);
+    }
+
+    return render;
+}
+
+} // namespace
+
+RegressionRender renderScenario (const RegressionScenario& scenario)
+{
+    constexpr auto sampleRate = RegressionScenario::sampleRate;
+    constexpr auto blockSize = RegressionScenario::blockSize;
+
+    TapSynthAudioProcessor processor (scenario.numVoices);
+
+    for (auto [id, value] : scenario.parameters)
+        setParameter (processor, id, value);
+
+    if (scenario.path == RegressionScenario::Path::processor)
+    {
+        prepareProcessor (processor, sampleRate, blockSize);
+
+        auto render = renderBlocks (scenario, processor.getTotalNumOutputChannels(),
+                                    [&] (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) { processor.processBlock (buffer, midi); },
+                                    [&]
+                                    {
+                                        auto numPlaying = 0;
+
+                                        for (auto& voice : processor.getSynth().getVoicePool())
+                                            numPlaying += voice.isVoiceActive() ? 1 : 0;
+
+                                        return numPlaying;
+                                    });
+
+        processor.releaseResources();
+        return render;
+    }
+
+    // The processor is only there for the parameters' plain values, the voice is played by a Synthesiser of its own
+    ParameterSnapshot parameters;
+    ParameterSnapshotReader (processor.treeState).read (parameters);
+
+    juce::Synthesiser synth;
+    auto* voice = new SynthVoice();
+    synth.addVoice (voice);
+    synth.addSound (new SynthSound());
+    synth.setCurrentPlaybackSampleRate (sampleRate);
+
+    voice->prepareToPlay (sampleRate, blockSize);
+    applyParameters (*voice, parameters);
+
+    return renderBlocks (scenario, 2,
+                         [&] (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midi) { synth.renderNextBlock (buffer, midi, 0, buffer.getNumSamples()); },
+                         [&] { return voice->isVoiceActive() ? 1 : 0; });
+}
+
+bool writeReferenceAudio (const juce::File& file, const juce::AudioBuffer<float>& audio)
+{
+    file.getParentDirectory().createDirectory();
+    file.deleteFile();
+
+    auto stream = file.createOutputStream();
+
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatWriter> writer (wavFormat.createWriterFor (stream.get(), RegressionScenario::sampleRate,
+                                                                                (unsigned int) audio.getNumChannels(), 32, {}, 0));
+
+    if (writer == nullptr)
+        return false;
+
+    stream.release();
+    return writer->writeFromAudioSampleBuffer (audio, 0, audio.getNumSamples());
+}
+
+bool readReferenceAudio (const juce::File& file, juce::AudioBuffer<float>& audio)
+{
+    auto stream = file.createInputStream();
+
+    if (stream == nullptr)
+        return false;
+
+    juce::WavAudioFormat wavFormat;
+    std::unique_ptr<juce::AudioFormatReader> reader (wavFormat.createReaderFor (stream.release(), true));
+
+    if (reader == nullptr)
+        return false;
+
+    audio.setSize ((int) reader->numChannels, (int) reader->lengthInSamples);
+    return reader->read (&audio, 0, (int) reader->lengthInSamples, 0, true, true);
+}
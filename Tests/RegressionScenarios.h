@@ -0,0 +1,69 @@
+/*
+  ==============================================================================
+
+    RegressionScenarios.h
+    Created: 18 Oct 2026 6:21:15am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+// Where the regression tests keep their reference audio and CPU budgets, and whether this run records new ones.
+// TestMain fills it in from the command line before any test runs
+struct RegressionOptions
+{
+    juce::File referenceDirectory;
+    bool updateReferences { false };    // --update-golden
+    bool updateBudgets { false };       // --update-budgets
+
+    static RegressionOptions& get();
+};
+
+// A fixed piece of MIDI played with a fixed patch, either through a single SynthVoice driven by a plain juce::Synthesiser
+// (just the oscillator, envelopes and filter) or through the whole processor
+struct RegressionScenario
+{
+    enum class Path
+    {
+        voice,
+        processor
+    };
+
+    struct Note
+    {
+        int noteNumber;
+        float velocity;
+        double startSeconds;
+        double lengthSeconds;
+    };
+
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    const char* name;
+    Path path;
+    int numVoices;
+    std::vector<std::pair<const char*, float>> parameters;     // plain values, every other parameter keeps its default
+    std::vector<Note> notes;
+    double seconds;
+
+    static const std::vector<RegressionScenario>& getAll();
+};
+
+// The audio a scenario rendered, plus how long the rendering itself took (filling in the MIDI and counting voices isn't timed)
+struct RegressionRender
+{
+    juce::AudioBuffer<float> audio;
+    double nanoseconds { 0.0 };
+    double voiceSamples { 0.0 };    // the samples of every block, times the voices that were playing in it
+};
+
+RegressionRender renderScenario (const RegressionScenario& scenario);
+
+// Reference audio is kept as 32-bit float WAV. The processor scenarios peak above full scale, which integer formats would clip
+bool writeReferenceAudio (const juce::File& file, const juce::AudioBuffer<float>& audio);
+bool readReferenceAudio (const juce::File& file, juce::AudioBuffer<float>& audio);
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    StageProfilerTests.cpp
+    Created: 18 Oct 2026 3:58:12am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+// Only built into the tests of a TAPSYNTH_PROFILING build, like the profiler itself
+#if TAPSYNTH_PROFILING
+class StageProfilerTests : public juce::UnitTest
+{
+public:
+    StageProfilerTests()
+        : juce::UnitTest ("Stage profiler", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        beginTest ("Records come out in order, and the ones that don't fit are dropped");
+        {
+            StageProfiler profiler (4);
+            StageTimes times;
+            times.cycles[StageTimes::filter] = 100;
+
+            // An AbstractFifo keeps one slot free
+            for (juce::uint32 block = 0; block < 5; ++block)
+                profiler.push (block, 7, 64, times);
+
+            expectEquals (profiler.getNumReady(), 3);
+            expectEquals ((int) profiler.getNumDropped(), 2);
+
+            StageProfiler::Record records[8];
+            expectEquals (profiler.pop (records, 8), 3);
+
+            for (int i = 0; i < 3; ++i)
+            {
+                expectEquals ((int) records[i].block, i);
+                expectEquals (records[i].voice, 7);
+                expectEquals ((int) records[i].cycles[StageTimes::filter], 100);
+            }
+
+            expectEquals (profiler.pop (records, 8), 0);
+        }
+
+        for (auto voiceParallel : { true, false })
+        {
+            beginTest (juce::String ("Every playing voice reports every stage it ran, ") + (voiceParallel ? "in SIMD groups" : "one at a time"));
+
+            TapSynthAudioProcessor processor (8);
+            processor.getSynth().setVoiceParallelRendering (voiceParallel);
+            processor.setRateAndBufferSizeDetails (48000.0, 256);
+            processor.prepareToPlay (48000.0, 256);
+
+            juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), 256);
+            juce::MidiBuffer midi;
+
+            for (int note = 0; note < 8; ++note)
+                midi.addEvent (juce::MidiMessage::noteOn (1, 48 + note, 0.8f), 0);
+
+            // The first block starts the notes, the second is what's measured
+            for (int block = 0; block < 2; ++block)
+            {
+                buffer.clear();
+                processor.processBlock (buffer, midi);
+                midi.clear();
+            }
+
+            auto& profiler = processor.getSynth().getStageProfiler();
+            std::vector<StageProfiler::Record> records (64);
+            const auto numRecords = profiler.pop (records.data(), (int) records.size());
+            expectEquals (numRecords, 16);
+
+            for (int i = 8; i < numRecords; ++i)
+            {
+                const auto& record = records[(size_t) i];
+                expectEquals ((int) record.block, 2);
+                expectEquals (record.numSamples, 256);
+
+                for (auto stage : { StageTimes::oscillator, StageTimes::fmModulator, StageTimes::ampEnvelope,
+                                    StageTimes::modEnvelope, StageTimes::filter, StageTimes::mixToOutput })
+                    expectGreaterThan ((double) record.cycles[(size_t) stage], 0.0, StageTimes::getStageName (stage));
+            }
+
+            processor.releaseResources();
+        }
+    }
+};
+
+static StageProfilerTests stageProfilerTests;
+#endif
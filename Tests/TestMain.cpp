@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    TestMain.cpp
+    Created: 17 Oct 2026 6:02:48pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "RegressionScenarios.h"
+
+#include <cstdio>
+
+#ifndef TAPSYNTH_REFERENCE_DIR
+ #define TAPSYNTH_REFERENCE_DIR "Tests/Golden"
+#endif
+
+// Runs every juce::UnitTest in the TapSynth category (or the one given with --category) and fails if any of them do.
+// --update-golden and --update-budgets record the regression tests' reference audio and CPU budgets instead of checking
+// them, --golden-dir keeps those somewhere other than Tests/Golden
+int main (int argc, char* argv[])
+{
+    // The processor's AudioProcessorValueTreeState expects a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args (argc, argv);
+    const auto category = args.containsOption ("--category") ? args.getValueForOption ("--category") : juce::String ("TapSynth");
+
+    auto& regression = RegressionOptions::get();
+    regression.referenceDirectory = juce::File::getCurrentWorkingDirectory()
+                                        .getChildFile (args.containsOption ("--golden-dir") ? args.getValueForOption ("--golden-dir")
+                                                                                            : juce::String (TAPSYNTH_REFERENCE_DIR));
+    regression.updateReferences = args.containsOption ("--update-golden");
+    regression.updateBudgets = args.containsOption ("--update-budgets");
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure (false);
+    runner.runTestsInCategory (category);
+
+    int numFailures = 0;
+
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        numFailures += runner.getResult (i)->failures;
+
+    if (runner.getNumResults() == 0)
+    {
+        std::printf ("error: no tests in category %s\n", category.toRawUTF8());
+        return 1;
+    }
+
+    return numFailures > 0 ? 1 : 0;
+}
@@ -0,0 +1,142 @@
+/*
+  ==============================================================================
+
+    VoiceAllocationTests.cpp
+    Created: 17 Oct 2026 7:31:58pm
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessorTestHelpers.h"
+
+class VoiceAllocationTests : public juce::UnitTest
+{
+public:
+    VoiceAllocationTests()
+        : juce::UnitTest ("Voice allocation", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        using Policy = VoiceAllocator::StealPolicy;
+
+        beginTest ("Steal policies pick the expected voice");
+        {
+            VoiceAllocator allocator (4);
+            int voiceFor[128] {};
+
+            for (auto note : { 60, 62, 64, 65 })
+            {
+                voiceFor[note] = allocator.takeFreeVoice();
+                expect (voiceFor[note] != VoiceAllocator::noVoice);
+                allocator.voiceStarted (voiceFor[note], 1, note);
+            }
+
+            expectEquals (allocator.takeFreeVoice(), (int) VoiceAllocator::noVoice);
+
+            allocator.voiceReleased (voiceFor[64]);
+            allocator.voiceReleased (voiceFor[62]);
+
+            allocator.setLevel (voiceFor[60], 0.9f);
+            allocator.setLevel (voiceFor[62], 0.5f);
+            allocator.setLevel (voiceFor[64], 0.7f);
+            allocator.setLevel (voiceFor[65], 0.1f);
+
+            expectEquals (allocator.findVoiceToSteal (Policy::oldest, 1, 70), voiceFor[60]);
+            expectEquals (allocator.findVoiceToSteal (Policy::releasedFirst, 1, 70), voiceFor[64]);
+            expectEquals (allocator.findVoiceToSteal (Policy::sameNote, 1, 62), voiceFor[62]);
+            expectEquals (allocator.findVoiceToSteal (Policy::sameNote, 1, 70), voiceFor[60]);
+            expectEquals (allocator.findVoiceToSteal (Policy::quietest, 1, 70), voiceFor[65]);
+
+            // A voice that has moved on to another note since the levels were taken is no longer the quietest
+            allocator.voiceStarted (voiceFor[62], 1, 70);
+            expectEquals (allocator.findVoiceToSteal (Policy::quietest, 1, 71), voiceFor[64]);
+
+            // New levels are picked up by the next steal
+            allocator.setLevel (voiceFor[60], 0.05f);
+            expectEquals (allocator.findVoiceToSteal (Policy::quietest, 1, 72), voiceFor[60]);
+
+            expectEquals (allocator.getFirstVoiceForNote (1, 62), (int) VoiceAllocator::noVoice);
+            expectEquals (allocator.getFirstVoiceForNote (1, 70), voiceFor[62]);
+
+            allocator.voiceFreed (voiceFor[65]);
+            expectEquals (allocator.takeFreeVoice(), voiceFor[65]);
+        }
+
+        beginTest ("A stolen note fades out before the new one starts");
+        {
+            constexpr int stealPosition = 100;
+
+            const auto held = render (1, Policy::oldest, { { 0, 48 } });
+            const auto stolen = render (1, Policy::oldest, { { 0, 48 }, { 4 * blockSize + stealPosition, 72 } });
+
+            const auto fadeLength = juce::roundToInt (sampleRate * 0.003);
+            const auto fadeStart = 4 * blockSize + stealPosition;
+
+            auto maxError = 0.0f;
+
+            for (int i = 0; i < fadeStart; ++i)
+                maxError = juce::jmax (maxError, std::abs (stolen.getSample (0, i) - held.getSample (0, i)));
+
+            for (int i = 0; i < fadeLength; ++i)
+            {
+                const auto expected = held.getSample (0, fadeStart + i) * (1.0f - (float) i / (float) fadeLength);
+                maxError = juce::jmax (maxError, std::abs (stolen.getSample (0, fadeStart + i) - expected));
+            }
+
+            expectLessThan (maxError, 1.0e-5f);
+            expectGreaterThan (std::abs (held.getSample (0, fadeStart)), 0.0f);
+        }
+
+        beginTest ("The same note policy retriggers the note's own voice");
+        {
+            for (auto policy : { Policy::oldest, Policy::sameNote })
+            {
+                TapSynthAudioProcessor processor (4);
+                prepare (processor, policy);
+
+                juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), blockSize);
+                juce::MidiBuffer midi;
+                midi.addEvent (juce::MidiMessage::noteOn (1, 60, 0.8f), 0);
+                midi.addEvent (juce::MidiMessage::noteOn (1, 60, 0.8f), 64);
+                processor.processBlock (buffer, midi);
+
+                int numActive = 0;
+
+                for (auto& voice : processor.getSynth().getVoicePool())
+                    numActive += voice.isVoiceActive() ? 1 : 0;
+
+                expectEquals (numActive, policy == Policy::sameNote ? 1 : 2);
+            }
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+
+    static void prepare (TapSynthAudioProcessor& processor, VoiceAllocator::StealPolicy policy)
+    {
+        setParameter (processor, "VOICESTEAL", (float) (int) policy);
+        prepareProcessor (processor, sampleRate, blockSize);
+    }
+
+    // Renders 8 blocks, starting each note at its sample position
+    static juce::AudioBuffer<float> render (int numVoices, VoiceAllocator::StealPolicy policy, std::initializer_list<std::pair<int, int>> notes)
+    {
+        TapSynthAudioProcessor processor (numVoices);
+        prepare (processor, policy);
+
+        std::vector<juce::MidiMessage> events;
+
+        for (auto [position, note] : notes)
+            events.push_back (juce::MidiMessage::noteOn (1, note, 0.8f).withTimeStamp (position));
+
+        return renderBlocks (processor, 8, events);
+    }
+};
+
+static VoiceAllocationTests voiceAllocationTests;
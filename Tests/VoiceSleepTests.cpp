@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    VoiceSleepTests.cpp
+    Created: 18 Oct 2026 12:14:48am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "ProcessorTestHelpers.h"
+
+class VoiceSleepTests : public juce::UnitTest
+{
+public:
+    VoiceSleepTests()
+        : juce::UnitTest ("Voice sleep", "TapSynth")
+    {
+    }
+
+    void runTest() override
+    {
+        for (auto resonance : { 1.0f, 10.0f })
+        {
+            beginTest ("Released voices go to sleep once they're silent, resonance " + juce::String (resonance));
+
+            TapSynthAudioProcessor processor (4);
+            prepareProcessor (processor, sampleRate, blockSize);
+            setParameter (processor, "FILTERRES", resonance);
+
+            juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), blockSize);
+            juce::MidiBuffer midi;
+
+            midi.addEvent (juce::MidiMessage::noteOn (1, 48, 0.8f), 0);
+            renderBlock (processor, buffer, midi);
+            expect (processor.getSynth().isSounding());
+
+            midi.addEvent (juce::MidiMessage::noteOff (1, 48), 0);
+
+            // The release is 0.4 s by default, the filter's tail adds a little to that
+            const auto maxBlocks = (int) (1.0 * sampleRate / blockSize);
+            auto lastPeak = 0.0f;
+            int block = 0;
+
+            for (; block < maxBlocks && processor.getSynth().isSounding(); ++block)
+            {
+                renderBlock (processor, buffer, midi);
+                lastPeak = buffer.getMagnitude (0, 0, blockSize);
+            }
+
+            expect (block < maxBlocks, "Still awake after a second");
+
+            // Nothing audible was cut off on the way
+            expectLessThan (lastPeak, 1.0e-3f);
+
+            renderBlock (processor, buffer, midi);
+            expectEquals (buffer.getMagnitude (0, 0, blockSize), 0.0f);
+        }
+
+        beginTest ("Parameters that change while every voice sleeps reach the voices with the next note");
+        {
+            TapSynthAudioProcessor processor (4);
+            prepareProcessor (processor, sampleRate, blockSize);
+
+            juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), blockSize);
+            juce::MidiBuffer midi;
+            renderBlock (processor, buffer, midi);
+
+            setParameter (processor, "VOICESTEAL", (float) VoiceAllocator::StealPolicy::oldest);
+            renderBlock (processor, buffer, midi);
+            expect (processor.getSynth().getStealPolicy() == VoiceAllocator::StealPolicy::releasedFirst);
+
+            midi.addEvent (juce::MidiMessage::noteOn (1, 60, 0.8f), 0);
+            renderBlock (processor, buffer, midi);
+            expect (processor.getSynth().getStealPolicy() == VoiceAllocator::StealPolicy::oldest);
+        }
+
+        beginTest ("Resetting the engine silences it at once and the next note plays as if nothing came before");
+        {
+            // Oversampled, so the decimators have state to carry over too
+            TapSynthAudioProcessor fresh (4), reused (4);
+
+            for (auto* processor : { &fresh, &reused })
+            {
+                setParameter (*processor, "OVERSAMPLING", 1.0f);
+                prepareProcessor (*processor, sampleRate, blockSize);
+            }
+
+            juce::AudioBuffer<float> buffer (reused.getTotalNumOutputChannels(), blockSize);
+            juce::MidiBuffer midi;
+
+            // Held notes, plus one that's queued for a voice that is still fading out a stolen note
+            for (auto note : { 48, 52, 55, 59, 62 })
+                midi.addEvent (juce::MidiMessage::noteOn (1, note, 0.8f), 250);
+
+            renderBlock (reused, buffer, midi);
+            reused.getSynth().reset();
+            expect (! reused.getSynth().isSounding());
+
+            renderBlock (reused, buffer, midi);
+            expectEquals (buffer.getMagnitude (0, blockSize), 0.0f);
+
+            const std::vector<juce::MidiMessage> note { juce::MidiMessage::noteOn (1, 64, 0.8f).withTimeStamp (10) };
+            const auto expected = renderBlocks (fresh, 8, note);
+            const auto actual = renderBlocks (reused, 8, note);
+
+            auto maxDifference = 0.0f;
+
+            for (int channel = 0; channel < expected.getNumChannels(); ++channel)
+                for (int i = 0; i < expected.getNumSamples(); ++i)
+                    maxDifference = juce::jmax (maxDifference, std::abs (expected.getSample (channel, i) - actual.getSample (channel, i)));
+
+            expectGreaterThan (expected.getMagnitude (0, expected.getNumSamples()), 0.0f);
+            expectLessThan (maxDifference, 1.0e-6f);
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 256;
+};
+
+static VoiceSleepTests voiceSleepTests;
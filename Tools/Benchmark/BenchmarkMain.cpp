@@ -0,0 +1,311 @@
+/*
+  ==============================================================================
+
+    BenchmarkMain.cpp
+    Created: 17 Oct 2026 10:12:40am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+// Scripted MIDI for the benchmark: a new chord of numNotes notes every chordSeconds, held for gateFraction of that time
+struct MidiScript
+{
+    double sampleRate { 44100.0 };
+    int numNotes { 4 };
+    double chordSeconds { 0.5 };
+    double gateFraction { 0.8 };
+
+    static int noteNumberFor (juce::int64 chord, int note)
+    {
+        // 5 and 96 share no factors, so every note of a chord is distinct even for very large chords
+        return 24 + (int) ((chord * 7 + note * 5) % 96);
+    }
+
+    void fillBlock (juce::MidiBuffer& midi, juce::int64 blockStart, int numSamples) const
+    {
+        midi.clear();
+
+        const auto chordLength = juce::jmax ((juce::int64) 1, (juce::int64) (chordSeconds * sampleRate));
+        const auto gateLength = (juce::int64) ((double) chordLength * gateFraction);
+        const auto blockEnd = blockStart + numSamples;
+
+        for (auto chord = blockStart / chordLength; chord * chordLength < blockEnd; ++chord)
+        {
+            const auto noteOnPosition = chord * chordLength;
+            const auto noteOffPosition = noteOnPosition + gateLength;
+
+            if (noteOnPosition >= blockStart)
+                for (int note = 0; note < numNotes; ++note)
+                    midi.addEvent (juce::MidiMessage::noteOn (1, noteNumberFor (chord, note), 0.8f), (int) (noteOnPosition - blockStart));
+
+            if (noteOffPosition >= blockStart && noteOffPosition < blockEnd)
+                for (int note = 0; note < numNotes; ++note)
+                    midi.addEvent (juce::MidiMessage::noteOff (1, noteNumberFor (chord, note)), (int) (noteOffPosition - blockStart));
+        }
+    }
+};
+
+struct ScenarioResult
+{
+    double realtimeFactor { 0.0 };
+    double nsPerSample { 0.0 };
+    double nsPerVoiceSample { 0.0 };
+    double p50Micros { 0.0 };
+    double p90Micros { 0.0 };
+    double p99Micros { 0.0 };
+    double maxMicros { 0.0 };
+    float peakLevel { 0.0f };
+};
+
+double percentile (const std::vector<double>& sortedValues, double proportion)
+{
+    if (sortedValues.empty())
+        return 0.0;
+
+    const auto index = (size_t) (proportion * (double) (sortedValues.size() - 1));
+    return sortedValues[juce::jmin (index, sortedValues.size() - 1)];
+}
+
+#if TAPSYNTH_PROFILING
+// Writes the stage times the profiler collected to a CSV file, or JSON Lines if the file's extension is .json.
+// Only the timed blocks are written, what the warm-up leaves behind is thrown away
+class ProfileWriter
+{
+public:
+    explicit ProfileWriter (const juce::File& file)
+        : isJson (file.hasFileExtension ("json")),
+          records (4096)
+    {
+        if (file.getFullPathName().isEmpty())
+            return;
+
+        file.deleteFile();
+        stream = file.createOutputStream();
+
+        if (stream == nullptr)
+            std::printf ("error: can't write the profile to %s\n", file.getFullPathName().toRawUTF8());
+        else if (! isJson)
+            StageProfiler::writeCsvHeader (*stream);
+    }
+
+    void drain (StageProfiler& profiler, bool shouldWrite)
+    {
+        for (int numRead; (numRead = profiler.pop (records.data(), (int) records.size())) > 0;)
+        {
+            if (stream == nullptr || ! shouldWrite)
+                continue;
+
+            if (isJson)
+                StageProfiler::writeJson (*stream, records.data(), numRead);
+            else
+                StageProfiler::writeCsv (*stream, records.data(), numRead);
+        }
+    }
+
+private:
+    const bool isJson;
+    std::vector<StageProfiler::Record> records;
+    std::unique_ptr<juce::FileOutputStream> stream;
+};
+#endif
+
+ScenarioResult runScenario (double sampleRate, int blockSize, double seconds, int numVoices, bool voiceParallel, bool multiCore,
+                            MidiScript script, const juce::File& profileFile)
+{
+    using Clock = std::chrono::steady_clock;
+
+    // A fresh processor per scenario so no state leaks between sample rates and block sizes
+    TapSynthAudioProcessor processor (numVoices);
+    processor.getSynth().setVoiceParallelRendering (voiceParallel);
+    processor.getSynth().setMultiCoreRendering (multiCore);
+    processor.setRateAndBufferSizeDetails (sampleRate, blockSize);
+    processor.prepareToPlay (sampleRate, blockSize);
+
+    script.sampleRate = sampleRate;
+
+    juce::AudioBuffer<float> buffer (processor.getTotalNumOutputChannels(), blockSize);
+    juce::MidiBuffer midi;
+    midi.ensureSize (4096);
+
+    // Warm up caches and let the first chord settle before anything is timed
+    const auto warmupBlocks = juce::jmax (1, (int) (0.25 * sampleRate / blockSize));
+    const auto timedBlocks = juce::jmax (1, (int) (seconds * sampleRate / blockSize));
+
+    std::vector<double> blockNanos;
+    blockNanos.reserve ((size_t) timedBlocks);
+
+    ScenarioResult result;
+    juce::int64 position = 0;
+    double totalNanos = 0.0;
+
+   #if TAPSYNTH_PROFILING
+    ProfileWriter profileWriter (profileFile);
+   #else
+    juce::ignoreUnused (profileFile);
+   #endif
+
+    for (int block = 0; block < warmupBlocks + timedBlocks; ++block)
+    {
+        script.fillBlock (midi, position, blockSize);
+        buffer.clear();
+
+        const auto start = Clock::now();
+        processor.processBlock (buffer, midi);
+        const auto elapsed = std::chrono::duration<double, std::nano> (Clock::now() - start).count();
+
+        position += blockSize;
+
+       #if TAPSYNTH_PROFILING
+        profileWriter.drain (processor.getSynth().getStageProfiler(), block >= warmupBlocks);
+       #endif
+
+        if (block < warmupBlocks)
+            continue;
+
+        blockNanos.push_back (elapsed);
+        totalNanos += elapsed;
+
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            result.peakLevel = juce::jmax (result.peakLevel, buffer.getMagnitude (channel, 0, blockSize));
+    }
+
+    processor.releaseResources();
+
+    const auto renderedSamples = (double) timedBlocks * blockSize;
+    result.realtimeFactor = (renderedSamples / sampleRate) / (totalNanos * 1.0e-9);
+    result.nsPerSample = totalNanos / renderedSamples;
+
+    // Every note of a chord gets its own voice as long as the synth has enough of them
+    result.nsPerVoiceSample = result.nsPerSample / juce::jmin (script.numNotes, processor.getNumVoices());
+
+    std::sort (blockNanos.begin(), blockNanos.end());
+    result.p50Micros = percentile (blockNanos, 0.50) * 1.0e-3;
+    result.p90Micros = percentile (blockNanos, 0.90) * 1.0e-3;
+    result.p99Micros = percentile (blockNanos, 0.99) * 1.0e-3;
+    result.maxMicros = blockNanos.back() * 1.0e-3;
+
+    return result;
+}
+
+std::vector<double> parseList (const juce::String& text)
+{
+    std::vector<double> values;
+
+    for (auto& token : juce::StringArray::fromTokens (text, ",", ""))
+        if (token.trim().isNotEmpty())
+            values.push_back (token.trim().getDoubleValue());
+
+    return values;
+}
+
+void printUsage()
+{
+    std::printf ("Usage: TapSynthBenchmark [--seconds=N] [--voices=N] [--notes=N] [--rates=44100,48000,...] [--blocks=32,64,...] [--scalar] [--multicore]\n"
+                 "                         [--profile=FILE]\n"
+                 "  --seconds    audio rendered per scenario, excluding warm-up (default 10)\n"
+                 "  --voices     polyphony of the synth (default %d, at most %d)\n"
+                 "  --notes      notes per scripted chord (default 4)\n"
+                 "  --rates      comma separated sample rates (default 44100,48000,96000)\n"
+                 "  --blocks     comma separated block sizes (default 32,64,128,256,512,1024)\n"
+                 "  --scalar     render every voice on its own instead of in SIMD groups\n"
+                 "  --multicore  spread the voices across the shared worker pool\n"
+                 "  --profile    write every voice's stage times to FILE (.csv, or .json for JSON Lines), with the sample rate\n"
+                 "               and block size added to the name when there are several scenarios. Needs a TAPSYNTH_PROFILING build\n",
+                 SynthEngine::defaultNumVoices, SynthEngine::maxVoices);
+}
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor's AudioProcessorValueTreeState expects a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    auto seconds = 10.0;
+    auto numVoices = SynthEngine::defaultNumVoices;
+    auto sampleRates = std::vector<double> { 44100.0, 48000.0, 96000.0 };
+    auto blockSizes = std::vector<double> { 32, 64, 128, 256, 512, 1024 };
+    MidiScript script;
+    const auto voiceParallel = ! args.containsOption ("--scalar");
+    const auto multiCore = args.containsOption ("--multicore");
+
+    if (args.containsOption ("--seconds"))  seconds = juce::jmax (0.1, args.getValueForOption ("--seconds").getDoubleValue());
+    if (args.containsOption ("--voices"))   numVoices = juce::jlimit (1, SynthEngine::maxVoices, args.getValueForOption ("--voices").getIntValue());
+    if (args.containsOption ("--notes"))    script.numNotes = juce::jlimit (1, 96, args.getValueForOption ("--notes").getIntValue());
+    if (args.containsOption ("--rates"))    sampleRates = parseList (args.getValueForOption ("--rates"));
+    if (args.containsOption ("--blocks"))   blockSizes = parseList (args.getValueForOption ("--blocks"));
+
+    if (sampleRates.empty() || blockSizes.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    const auto profilePath = args.getValueForOption ("--profile");
+    const auto numScenarios = sampleRates.size() * blockSizes.size();
+
+   #if ! TAPSYNTH_PROFILING
+    if (profilePath.isNotEmpty())
+    {
+        std::printf ("error: --profile needs a build configured with TAPSYNTH_PROFILING (and not as Release)\n");
+        return 1;
+    }
+   #endif
+
+    std::printf ("TapSynth benchmark: %.1f s per scenario, %d voices, %d notes per chord, %s rendering%s\n\n",
+                 seconds, numVoices, script.numNotes, voiceParallel ? "voice-parallel" : "scalar", multiCore ? " on all cores" : "");
+    std::printf ("%8s %6s %10s %10s %12s %10s %10s %10s %10s\n", "rate", "block", "realtime", "ns/sample", "ns/smp/voice", "p50 us", "p90 us", "p99 us", "max us");
+
+    auto sawSilence = false;
+
+    for (auto sampleRate : sampleRates)
+    {
+        for (auto blockSizeValue : blockSizes)
+        {
+            const auto blockSize = juce::jmax (1, (int) blockSizeValue);
+            auto profileFile = profilePath.isEmpty() ? juce::File() : juce::File::getCurrentWorkingDirectory().getChildFile (profilePath);
+
+            if (numScenarios > 1 && profilePath.isNotEmpty())
+                profileFile = profileFile.getSiblingFile (profileFile.getFileNameWithoutExtension() + "-" + juce::String ((int) sampleRate)
+                                                          + "-" + juce::String (blockSize) + profileFile.getFileExtension());
+
+            const auto result = runScenario (sampleRate, blockSize, seconds, numVoices, voiceParallel, multiCore, script, profileFile);
+
+            std::printf ("%8.0f %6d %9.1fx %10.1f %12.1f %10.2f %10.2f %10.2f %10.2f\n",
+                         sampleRate, blockSize, result.realtimeFactor, result.nsPerSample, result.nsPerVoiceSample,
+                         result.p50Micros, result.p90Micros, result.p99Micros, result.maxMicros);
+
+            sawSilence = sawSilence || result.peakLevel <= 0.0f;
+        }
+    }
+
+    // A synth that renders nothing is very fast, so make sure that never passes as a good result
+    if (sawSilence)
+    {
+        std::printf ("\nerror: at least one scenario rendered silence\n");
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,401 @@
+/*
+  ==============================================================================
+
+    RenderMain.cpp
+    Created: 18 Oct 2026 5:47:53am
+    Author:  Hong Jyun Wang
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include "PluginProcessor.h"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+
+struct RenderSettings
+{
+    double sampleRate { 48000.0 };
+    int blockSize { 512 };
+    int bitsPerSample { 24 };
+
+    // How long the notes may ring on after the last MIDI event. Rendering stops earlier once every voice is silent
+    double maxTailSeconds { 10.0 };
+
+    // The processor state each file starts from, as getStateInformation writes it
+    juce::MemoryBlock patchState;
+
+    // The programs that MIDI program changes pick from. Without one they're ignored, whatever bank the user has installed
+    juce::File presetBankFile;
+};
+
+struct RenderJob
+{
+    juce::File midiFile;
+    juce::File wavFile;
+};
+
+struct RenderResult
+{
+    juce::String error;
+    double audioSeconds { 0.0 };
+    double renderSeconds { 0.0 };
+};
+
+// Every track of a MIDI file merged into one sequence, timed in seconds. Meta events are left out
+bool readMidiFile (const juce::File& file, juce::MidiMessageSequence& sequence, juce::String& error)
+{
+    juce::FileInputStream stream (file);
+    juce::MidiFile midiFile;
+
+    if (! stream.openedOk() || ! midiFile.readFrom (stream))
+    {
+        error = "can't read the MIDI file";
+        return false;
+    }
+
+    midiFile.convertTimestampTicksToSeconds();
+    sequence.clear();
+
+    for (int track = 0; track < midiFile.getNumTracks(); ++track)
+        for (auto* event : *midiFile.getTrack (track))
+            if (! event->message.isMetaEvent())
+                sequence.addEvent (event->message);
+
+    sequence.sort();
+    return true;
+}
+
+//==============================================================================
+// Renders MIDI files to WAV one after the other with its own processor. The samples go to the disk through a
+// ThreadedWriter, so the render only ever waits for the disk when the writer's whole FIFO is full
+class Renderer
+{
+public:
+    Renderer (const RenderSettings& settingsToUse, juce::TimeSliceThread& writerThreadToUse)
+        : settings (settingsToUse),
+          writerThread (writerThreadToUse),
+          processor (SynthEngine::defaultNumVoices, settingsToUse.presetBankFile)
+    {
+        // Bounces get the offline oversampling, and each file gets a whole core, so the voices stay on this thread
+        processor.setNonRealtime (true);
+        processor.getSynth().setMultiCoreRendering (false);
+        processor.setRateAndBufferSizeDetails (settings.sampleRate, settings.blockSize);
+
+        buffer.setSize (processor.getTotalNumOutputChannels(), settings.blockSize);
+        midi.ensureSize (4096);
+    }
+
+    RenderResult render (const RenderJob& job)
+    {
+        RenderResult result;
+        const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+        juce::MidiMessageSequence sequence;
+
+        if (! readMidiFile (job.midiFile, sequence, result.error))
+            return result;
+
+        // Every file starts from the same patch with no notes playing, whatever the previous one left behind. A file can stop at
+        // the tail limit with notes still ringing, and allNotesOff would only fade those out in the next file's first block.
+        // A program change from the previous file would carry on too, since nothing applies it to the parameters here
+        processor.resetPlaybackState();
+        processor.setStateInformation (settings.patchState.getData(), (int) settings.patchState.getSize());
+        processor.prepareToPlay (settings.sampleRate, settings.blockSize);
+
+        auto writer = createWriter (job.wavFile, result.error);
+
+        if (writer == nullptr)
+            return result;
+
+        const auto endOfMidi = (juce::int64) std::ceil (sequence.getEndTime() * settings.sampleRate);
+        const auto endOfTail = endOfMidi + (juce::int64) (settings.maxTailSeconds * settings.sampleRate);
+        auto nextEvent = 0;
+        juce::int64 position = 0;
+
+        while (position < endOfMidi || (position < endOfTail && processor.getSynth().isSounding()))
+        {
+            const auto numSamples = settings.blockSize;
+            const auto blockEnd = position + numSamples;
+            midi.clear();
+
+            for (; nextEvent < sequence.getNumEvents(); ++nextEvent)
+            {
+                const auto& message = sequence.getEventPointer (nextEvent)->message;
+                const auto samplePosition = juce::jmax (position, (juce::int64) std::llround (message.getTimeStamp() * settings.sampleRate));
+
+                if (samplePosition >= blockEnd)
+                    break;
+
+                midi.addEvent (message, (int) (samplePosition - position));
+            }
+
+            buffer.clear();
+            processor.processBlock (buffer, midi);
+
+            // A full FIFO means the disk is behind, and waiting for it is the only choice that doesn't lose audio
+            while (! writer->write (buffer.getArrayOfReadPointers(), numSamples))
+                juce::Thread::sleep (1);
+
+            position += numSamples;
+        }
+
+        processor.releaseResources();
+
+        // Whatever is still in the FIFO is written out before the writer goes
+        writer.reset();
+
+        result.audioSeconds = (double) position / settings.sampleRate;
+        result.renderSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+        return result;
+    }
+
+private:
+    std::unique_ptr<juce::AudioFormatWriter::ThreadedWriter> createWriter (const juce::File& file, juce::String& error)
+    {
+        // Room for a few seconds of audio, so a slow disk can catch up without holding the render up
+        constexpr int fifoSamples = 1 << 18;
+
+        file.getParentDirectory().createDirectory();
+        file.deleteFile();
+
+        auto stream = file.createOutputStream();
+        juce::WavAudioFormat wavFormat;
+
+        std::unique_ptr<juce::AudioFormatWriter> writer (stream == nullptr ? nullptr
+            : wavFormat.createWriterFor (stream.get(), settings.sampleRate, (unsigned int) buffer.getNumChannels(), settings.bitsPerSample, {}, 0));
+
+        if (writer == nullptr)
+        {
+            error = "can't write " + file.getFullPathName();
+            return {};
+        }
+
+        // The writer owns the stream from here on
+        stream.release();
+        return std::make_unique<juce::AudioFormatWriter::ThreadedWriter> (writer.release(), writerThread, fifoSamples);
+    }
+
+    const RenderSettings& settings;
+    juce::TimeSliceThread& writerThread;
+
+    TapSynthAudioProcessor processor;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+};
+
+//==============================================================================
+// One worker per core, each with its own Renderer, taking the next job until there are none left
+class RenderWorker : public juce::Thread
+{
+public:
+    RenderWorker (const RenderSettings& settings, juce::TimeSliceThread& writerThread, const std::vector<RenderJob>& jobsToRender,
+                  std::atomic<size_t>& nextJobToTake, std::vector<RenderResult>& resultsToFill, std::mutex& printLockToUse)
+        : juce::Thread ("TapSynth render worker"),
+          renderer (settings, writerThread),
+          jobs (jobsToRender),
+          nextJob (nextJobToTake),
+          results (resultsToFill),
+          printLock (printLockToUse)
+    {
+    }
+
+    void run() override
+    {
+        for (auto index = nextJob++; index < jobs.size() && ! threadShouldExit(); index = nextJob++)
+        {
+            auto& result = results[index] = renderer.render (jobs[index]);
+
+            const std::lock_guard<std::mutex> lock (printLock);
+
+            if (result.error.isNotEmpty())
+                std::printf ("failed   %s: %s\n", jobs[index].midiFile.getFullPathName().toRawUTF8(), result.error.toRawUTF8());
+            else
+                std::printf ("rendered %s (%.1f s of audio in %.2f s, %.1fx realtime)\n", jobs[index].wavFile.getFullPathName().toRawUTF8(),
+                             result.audioSeconds, result.renderSeconds, result.audioSeconds / juce::jmax (1.0e-6, result.renderSeconds));
+        }
+    }
+
+private:
+    Renderer renderer;
+    const std::vector<RenderJob>& jobs;
+    std::atomic<size_t>& nextJob;
+    std::vector<RenderResult>& results;
+    std::mutex& printLock;
+};
+
+// A MIDI file renders next to itself, or into outputDirectory. Files found in a directory keep their place below it
+void addJobs (const juce::File& input, const juce::File& outputDirectory, std::vector<RenderJob>& jobs)
+{
+    if (input.isDirectory())
+    {
+        for (auto& midiFile : input.findChildFiles (juce::File::findFiles, true, "*.mid;*.midi"))
+        {
+            const auto target = outputDirectory == juce::File() ? midiFile
+                                                                : outputDirectory.getChildFile (midiFile.getRelativePathFrom (input));
+            jobs.push_back ({ midiFile, target.withFileExtension ("wav") });
+        }
+
+        return;
+    }
+
+    const auto target = outputDirectory == juce::File() ? input : outputDirectory.getChildFile (input.getFileName());
+    jobs.push_back ({ input, target.withFileExtension ("wav") });
+}
+
+void printUsage()
+{
+    std::printf ("Usage: TapSynthRender [--patch=FILE] [--bank=FILE] [--output=DIR] [--jobs=N] [--rate=N] [--block=N] [--bits=16|24|32] [--tail=SECONDS]\n"
+                 "                      FILE_OR_DIRECTORY...\n"
+                 "  Renders MIDI files (or every .mid and .midi file below a directory) to WAV as fast as the CPU allows.\n"
+                 "  --patch   processor state to start every file from, as the plugin saves it (default: the default patch)\n"
+                 "  --bank    preset bank for MIDI program changes to pick from (default: none, program changes are ignored)\n"
+                 "  --output  directory for the WAV files (default: next to each MIDI file)\n"
+                 "  --jobs    files rendered at once, one processor each (default: one per core)\n"
+                 "  --rate    sample rate (default 48000)\n"
+                 "  --block   block size (default 512)\n"
+                 "  --bits    bits per sample (default 24)\n"
+                 "  --tail    longest time the notes may ring after the last MIDI event, in seconds (default 10)\n");
+}
+
+} // namespace
+
+//==============================================================================
+int main (int argc, char* argv[])
+{
+    // The processor's AudioProcessorValueTreeState expects a message manager to exist
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ArgumentList args (argc, argv);
+
+    if (args.containsOption ("--help|-h"))
+    {
+        printUsage();
+        return 0;
+    }
+
+    RenderSettings settings;
+    auto numJobs = juce::SystemStats::getNumCpus();
+
+    if (args.containsOption ("--rate"))     settings.sampleRate = juce::jlimit (8000.0, 384000.0, args.getValueForOption ("--rate").getDoubleValue());
+    if (args.containsOption ("--block"))    settings.blockSize = juce::jlimit (1, 8192, args.getValueForOption ("--block").getIntValue());
+    if (args.containsOption ("--bits"))     settings.bitsPerSample = args.getValueForOption ("--bits").getIntValue();
+    if (args.containsOption ("--tail"))     settings.maxTailSeconds = juce::jmax (0.0, args.getValueForOption ("--tail").getDoubleValue());
+    if (args.containsOption ("--jobs"))     numJobs = juce::jmax (1, args.getValueForOption ("--jobs").getIntValue());
+
+    if (settings.bitsPerSample != 16 && settings.bitsPerSample != 24 && settings.bitsPerSample != 32)
+    {
+        printUsage();
+        return 1;
+    }
+
+    if (args.containsOption ("--patch"))
+    {
+        const auto patchFile = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--patch"));
+        juce::MemoryBlock state;
+        ParameterSnapshot parameters;
+        std::bitset<ParameterSnapshot::numParameters> isPresent;
+
+        if (! patchFile.loadFileAsData (state) || ! PatchState::read (state.getData(), state.getSize(), parameters, isPresent))
+        {
+            std::printf ("error: %s isn't a TapSynth patch\n", patchFile.getFullPathName().toRawUTF8());
+            return 1;
+        }
+
+        settings.patchState = state;
+    }
+    else
+    {
+        // Without a patch every file starts from the parameters' defaults
+        TapSynthAudioProcessor defaults;
+        defaults.getStateInformation (settings.patchState);
+    }
+
+    if (args.containsOption ("--bank"))
+    {
+        settings.presetBankFile = juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--bank"));
+        TapSynthAudioProcessor probe;
+
+        if (! probe.loadPresetBank (settings.presetBankFile))
+        {
+            std::printf ("error: %s isn't a TapSynth preset bank\n", settings.presetBankFile.getFullPathName().toRawUTF8());
+            return 1;
+        }
+    }
+
+    const auto outputDirectory = args.containsOption ("--output")
+                               ? juce::File::getCurrentWorkingDirectory().getChildFile (args.getValueForOption ("--output"))
+                               : juce::File();
+
+    std::vector<RenderJob> jobs;
+
+    for (auto& argument : args.arguments)
+    {
+        if (argument.isOption())
+            continue;
+
+        const auto input = argument.resolveAsFile();
+
+        if (! input.exists())
+        {
+            std::printf ("error: %s doesn't exist\n", input.getFullPathName().toRawUTF8());
+            return 1;
+        }
+
+        addJobs (input, outputDirectory, jobs);
+    }
+
+    if (jobs.empty())
+    {
+        printUsage();
+        return 1;
+    }
+
+    numJobs = juce::jmin (numJobs, (int) jobs.size());
+    std::printf ("TapSynth render: %d files, %d at a time, %.0f Hz, %d bit\n\n", (int) jobs.size(), numJobs, settings.sampleRate, settings.bitsPerSample);
+
+    // One thread does all the writing, the workers only ever hand it full blocks
+    juce::TimeSliceThread writerThread ("TapSynth WAV writer");
+    writerThread.startThread();
+
+    std::atomic<size_t> nextJob { 0 };
+    std::vector<RenderResult> results (jobs.size());
+    std::mutex printLock;
+    const auto startTime = juce::Time::getMillisecondCounterHiRes();
+
+    {
+        std::vector<std::unique_ptr<RenderWorker>> workers;
+
+        for (int i = 0; i < numJobs; ++i)
+            workers.push_back (std::make_unique<RenderWorker> (settings, writerThread, jobs, nextJob, results, printLock));
+
+        for (auto& worker : workers)
+            worker->startThread();
+
+        for (auto& worker : workers)
+            worker->waitForThreadToExit (-1);
+    }
+
+    writerThread.stopThread (10000);
+
+    const auto wallSeconds = (juce::Time::getMillisecondCounterHiRes() - startTime) * 0.001;
+    auto audioSeconds = 0.0;
+    auto numFailed = 0;
+
+    for (auto& result : results)
+    {
+        audioSeconds += result.audioSeconds;
+        numFailed += result.error.isNotEmpty() ? 1 : 0;
+    }
+
+    std::printf ("\n%d of %d files rendered: %.1f s of audio in %.2f s, %.1fx realtime\n", (int) jobs.size() - numFailed, (int) jobs.size(),
+                 audioSeconds, wallSeconds, audioSeconds / juce::jmax (1.0e-6, wallSeconds));
+
+    return numFailed > 0 ? 1 : 0;
+}